@@ -0,0 +1,278 @@
+/****************************************************************************************************/
+/*                                                                                                  */
+/* @module        : Cpp 11 features examples                                                        */
+/* @file          : benchHarness.h                                                                  */
+/* @brief         : Warmup, repetitions, percentiles and JSON output for the benchmarks             */
+/* @input         :                                                                                 */
+/* @outpu         :                                                                                 */
+/* @date          : 16-October-2026                                                                 */
+/* @author        : Pratik Patil                                                                    */
+/* License        :                                                                                 */
+/*               Copyright (C) 2017  Pratik Patil                                                   */
+/*                                                                                                  */
+/*               This program is free software: you can redistribute it and/or modify               */
+/*               it under the terms of the GNU General Public License Version 3 as published by     */
+/*               the Free Software Foundation.                                                      */
+/*                                                                                                  */
+/*               This program is distributed in the hope that it will be useful,                    */
+/*               but WITHOUT ANY WARRANTY; without even the implied warranty of                     */
+/*               MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                      */
+/*               GNU General Public License for more details.                                       */
+/*                                                                                                  */
+/*               You should have received a copy of the GNU General Public License                  */
+/*               along with this program.  If not, see <http://www.gnu.org/licenses/>.              */
+/****************************************************************************************************/
+#ifndef BENCHHARNESS_H_
+#define BENCHHARNESS_H_
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <deque>
+#include <fstream>
+#include <initializer_list>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/*
+ * Description :
+ *   benchHarness runs a body many times and reports nanoseconds per call:
+ *   - the number of calls per sample is doubled until a sample takes at least s_minSampleNs, then
+ *     the body keeps running for the warmup time before anything is recorded,
+ *   - every repetition gives one sample; min, median, mean, p90, p99, max and the standard
+ *     deviation of the samples are printed and, with --json, written out together with the
+ *     compiler version so runs of different compilers can be compared.
+ *
+ *   doNotOptimize (value) makes the compiler assume value is read, clobberMemory () that all
+ *   memory is read and written. Without them the optimizer may drop the work that is measured.
+ *
+ *   Command line : [--json file] [--reps n] [--warmup ms] [--filter text], anything else is left
+ *   to the benchmark in arguments () (sizes, thread counts).
+ */
+
+template<class T>
+  inline void
+  doNotOptimize (const T& value)
+  {
+    asm volatile ("" : : "g" (&value) : "memory");
+  }
+
+inline void
+clobberMemory ()
+{
+  asm volatile ("" : : : "memory");
+}
+
+struct benchResult
+{
+  std::string name;
+  size_t iterations;
+  std::vector<double> samples; // ns per call, sorted
+  double mean;
+  double stddev;
+
+  double
+  percentile (double p) const
+  {
+    size_t rank = size_t (std::ceil (p / 100.0 * samples.size ()));
+    return samples[rank ? rank - 1 : 0];
+  }
+};
+
+class benchHarness
+{
+public:
+  static constexpr double s_minSampleNs = 1e6;
+  static const int s_nameWidth = 44;
+  static const int s_columnWidth = 14; // 10 s in ns with two decimals
+
+  ///
+  /// reps and warmupMs are the defaults --reps / --warmup override. Benchmarks of long running
+  /// bodies (whole sorts, files) pass smaller ones.
+  ///
+  benchHarness (int argc, char* argv[], int reps = 30, int warmupMs = 50) :
+      m_reps (reps), m_warmupMs (warmupMs)
+  {
+    for (int i = 1; i < argc; ++i)
+      if (i + 1 < argc && !strcmp (argv[i], "--json"))
+	m_json = argv[++i];
+      else if (i + 1 < argc && !strcmp (argv[i], "--reps"))
+	m_reps = std::max (atoi (argv[++i]), 1);
+      else if (i + 1 < argc && !strcmp (argv[i], "--warmup"))
+	m_warmupMs = std::max (atoi (argv[++i]), 0);
+      else if (i + 1 < argc && !strcmp (argv[i], "--filter"))
+	m_filter = argv[++i];
+      else
+	m_arguments.push_back (argv[i]);
+    std::cout << std::left << std::setw (s_nameWidth) << "benchmark" << std::right;
+    for (const char* column : { "min ns", "median", "mean", "p90", "p99", "max", "stddev" })
+      std::cout << ' ' << std::setw (s_columnWidth) << column;
+    std::cout << std::endl;
+  }
+  ~benchHarness ()
+  {
+    if (!m_json.empty ())
+      writeJson ();
+  }
+
+  ///
+  /// Command line arguments which are not harness options, in order
+  ///
+  const std::vector<std::string>&
+  arguments () const
+  {
+    return m_arguments;
+  }
+
+  ///
+  /// i-th argument () as a number, fallback when it is missing
+  ///
+  double
+  argument (size_t i, double fallback) const
+  {
+    return i < m_arguments.size () ? strtod (m_arguments[i].c_str (), nullptr) : fallback;
+  }
+
+  ///
+  /// Times body (). Returns the result, which lives as long as the harness, or nullptr when
+  /// --filter skipped it.
+  ///
+  template<class BODY>
+    const benchResult*
+    run (const std::string& name, BODY body)
+    {
+      return measure (name, [&body](size_t iterations)
+	{ return timeNs (body, iterations);});
+    }
+
+  ///
+  /// Times body () only, setup () runs untimed before every call, e.g. to refill the input of a
+  /// sort. Meant for bodies which take far longer than reading the clock.
+  ///
+  template<class SETUP, class BODY>
+    const benchResult*
+    run (const std::string& name, SETUP setup, BODY body)
+    {
+      return measure (name, [&setup, &body](size_t iterations)
+	{
+	  double ns = 0;
+	  for (size_t i = 0; i < iterations; ++i)
+	    {
+	      setup ();
+	      ns += timeNs (body, 1);
+	    }
+	  return ns;
+	});
+    }
+
+private:
+  typedef std::chrono::steady_clock clock;
+
+  int m_reps;
+  int m_warmupMs;
+  std::string m_json;
+  std::string m_filter;
+  std::vector<std::string> m_arguments;
+  std::deque<benchResult> m_results;
+
+  ///
+  /// sample (iterations) returns the ns iterations calls took
+  ///
+  template<class SAMPLE>
+    const benchResult*
+    measure (const std::string& name, SAMPLE sample)
+    {
+      if (name.find (m_filter) == std::string::npos)
+	return nullptr;
+      benchResult r;
+      r.name = name;
+      r.iterations = 1;
+      while (sample (r.iterations) < s_minSampleNs)
+	r.iterations *= 2;
+      auto warmupEnd = clock::now () + std::chrono::milliseconds (m_warmupMs);
+      while (clock::now () < warmupEnd)
+	sample (r.iterations);
+
+      for (int rep = 0; rep < m_reps; ++rep)
+	r.samples.push_back (sample (r.iterations) / r.iterations);
+      std::sort (r.samples.begin (), r.samples.end ());
+      double sum = 0, squares = 0;
+      for (double s : r.samples)
+	sum += s;
+      r.mean = sum / r.samples.size ();
+      for (double s : r.samples)
+	squares += (s - r.mean) * (s - r.mean);
+      r.stddev = std::sqrt (squares / r.samples.size ());
+
+      std::cout << std::left << std::setw (s_nameWidth) << name << std::right << std::fixed
+	  << std::setprecision (2);
+      // the blank keeps columns apart even when a value is wider than the column
+      for (double value : { r.samples.front (), r.percentile (50), r.mean, r.percentile (90),
+	  r.percentile (99), r.samples.back (), r.stddev })
+	std::cout << ' ' << std::setw (s_columnWidth) << value;
+      std::cout << std::endl;
+      m_results.push_back (r);
+      return &m_results.back ();
+    }
+
+  template<class BODY>
+    static double
+    timeNs (BODY& body, size_t iterations)
+    {
+      auto start = clock::now ();
+      for (size_t i = 0; i < iterations; ++i)
+	body ();
+      auto stop = clock::now ();
+      return std::chrono::duration<double, std::nano> (stop - start).count ();
+    }
+
+  static std::string
+  quoted (const std::string& s)
+  {
+    std::string q = "\"";
+    for (char c : s)
+      {
+	if (c == '"' || c == '\\')
+	  q += '\\';
+	q += c;
+      }
+    return q + "\"";
+  }
+
+  void
+  writeJson () const
+  {
+    std::ofstream out (m_json);
+    char date[32];
+    time_t now = time (nullptr);
+    strftime (date, sizeof(date), "%Y-%m-%dT%H:%M:%S", localtime (&now));
+    out << std::setprecision (3) << std::fixed;
+    out << "{\n  \"context\": {\n    \"date\": " << quoted (date) << ",\n    \"compiler\": "
+	<< quoted (__VERSION__) << ",\n    \"cplusplus\": " << __cplusplus
+	<< ",\n    \"optimized\": "
+#ifdef __OPTIMIZE__
+	<< "true"
+#else
+	<< "false"
+#endif
+	<< ",\n    \"repetitions\": " << m_reps << "\n  },\n  \"benchmarks\": [";
+    for (size_t i = 0; i < m_results.size (); ++i)
+      {
+	const benchResult& r = m_results[i];
+	out << (i ? "," : "") << "\n    {\n      \"name\": " << quoted (r.name)
+	    << ",\n      \"iterations\": " << r.iterations << ",\n      \"min_ns\": "
+	    << r.samples.front () << ",\n      \"median_ns\": " << r.percentile (50)
+	    << ",\n      \"mean_ns\": " << r.mean << ",\n      \"p90_ns\": " << r.percentile (90)
+	    << ",\n      \"p99_ns\": " << r.percentile (99) << ",\n      \"max_ns\": "
+	    << r.samples.back () << ",\n      \"stddev_ns\": " << r.stddev << "\n    }";
+      }
+    out << "\n  ]\n}\n";
+  }
+};
+
+#endif /* BENCHHARNESS_H_ */
@@ -0,0 +1,164 @@
+/****************************************************************************************************/
+/*                                                                                                  */
+/* @module        : Cpp 11 features examples                                                        */
+/* @file          : dispatchBench.cpp                                                               */
+/* @brief         : Callback call and construction cost: pointers, std::function, functionRef, tags */
+/* @input         :                                                                                 */
+/* @outpu         :                                                                                 */
+/* @date          : 16-October-2026                                                                 */
+/* @author        : Pratik Patil                                                                    */
+/* License        :                                                                                 */
+/*               Copyright (C) 2017  Pratik Patil                                                   */
+/*                                                                                                  */
+/*               This program is free software: you can redistribute it and/or modify               */
+/*               it under the terms of the GNU General Public License Version 3 as published by     */
+/*               the Free Software Foundation.                                                      */
+/*                                                                                                  */
+/*               This program is distributed in the hope that it will be useful,                    */
+/*               but WITHOUT ANY WARRANTY; without even the implied warranty of                     */
+/*               MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                      */
+/*               GNU General Public License for more details.                                       */
+/*                                                                                                  */
+/*               You should have received a copy of the GNU General Public License                  */
+/*               along with this program.  If not, see <http://www.gnu.org/licenses/>.              */
+/****************************************************************************************************/
+#include <functional>
+#include <vector>
+#include "benchHarness.h"
+#include "../src/functionRef.h"
+#include "../src/tagDispatcher.h"
+
+/*
+ * Description :
+ * A tight loop calling a callback for 1024 values, with the callback held as a function pointer,
+ * std::function, functionRef, inplaceFunction and a tagDispatcher handler, then the cost of
+ * creating a callback with three captured pointers (std::function allocates for it), then message
+ * dispatch by a run time id through a table of std::function against tagDispatcher::call.
+ *
+ * usage : dispatchBench [--json file] [--reps n] [--warmup ms] [--filter text]
+ */
+
+static const int s_values = 1024;
+static long long g_sum = 0;
+
+void
+addToSum (int v)
+{
+  g_sum += v;
+}
+
+template<class CALLBACK>
+  void
+  callAll (CALLBACK& callback)
+  {
+    for (int i = 0; i < s_values; ++i)
+      callback (i);
+  }
+
+// noinline: as if it were in another translation unit, otherwise the call is resolved and inlined
+void __attribute__((noinline))
+callRef (functionRef<void
+(int)> callback)
+{
+  for (int i = 0; i < s_values; ++i)
+    callback (i);
+}
+
+struct addTag
+{
+};
+struct subtractTag
+{
+};
+struct multiplyTag
+{
+};
+
+int
+main (int argc, char* argv[])
+{
+  benchHarness bench (argc, argv);
+  long long sum = 0;
+  auto add = [&sum](int v)
+    { sum += v;};
+
+  void (*volatile pointer) (int) = addToSum; // volatile: the call can't be resolved at compile time
+  bench.run ("loop: function pointer", [&]()
+    {
+      void (*p) (int) = pointer;
+      callAll (p);
+      doNotOptimize (g_sum);
+    });
+  std::function<void
+  (int)> function = add;
+  bench.run ("loop: std::function", [&]()
+    {
+      callAll (function);
+      doNotOptimize (sum);
+    });
+  bench.run ("loop: functionRef", [&]()
+    {
+      callRef (add);
+      doNotOptimize (sum);
+    });
+  inplaceFunction<void
+  (int)> inplace = add;
+  bench.run ("loop: inplaceFunction", [&]()
+    {
+      callAll (inplace);
+      doNotOptimize (sum);
+    });
+  auto dispatcher = makeTagDispatcher (onTag<addTag> (add));
+  bench.run ("loop: tagDispatcher", [&]()
+    {
+      for (int i = 0; i < s_values; ++i)
+	dispatcher (addTag (), i);
+      doNotOptimize (sum);
+    });
+
+  long long a = 1, b = 2, c = 3;
+  bench.run ("create: std::function, 3 captures", [&]()
+    {
+      std::function<long long
+      (int)> f = [&a, &b, &c](int v)
+	{ return a + b + c + v;};
+      doNotOptimize (f);
+    });
+  bench.run ("create: inplaceFunction, 3 captures", [&]()
+    {
+      inplaceFunction<long long
+      (int)> f = [&a, &b, &c](int v)
+	{ return a + b + c + v;};
+      doNotOptimize (f);
+    });
+
+  std::vector<int> ids (s_values);
+  for (int i = 0; i < s_values; ++i)
+    ids[i] = i * 7 % 3;
+  // unsigned: the running product wraps, in int it would overflow (undefined behaviour)
+  std::function<unsigned
+  (unsigned, unsigned)> table[] =
+    { [](unsigned x, unsigned v)
+      { return x + v;}, [](unsigned x, unsigned v)
+      { return x - v;}, [](unsigned x, unsigned v)
+      { return x * v;} };
+  bench.run ("by id: std::function table", [&]()
+    {
+      unsigned x = 1;
+      for (int i = 0; i < s_values; ++i)
+	x = table[ids[i]] (x, unsigned (i));
+      doNotOptimize (x);
+    });
+  auto handlers = makeTagDispatcher (onTag<addTag> ([](unsigned x, unsigned v)
+    { return x + v;}), onTag<subtractTag> ([](unsigned x, unsigned v)
+    { return x - v;}), onTag<multiplyTag> ([](unsigned x, unsigned v)
+    { return x * v;}));
+  bench.run ("by id: tagDispatcher::call", [&]()
+    {
+      unsigned x = 1;
+      for (int i = 0; i < s_values; ++i)
+	x = handlers.call<unsigned> (ids[i], x, unsigned (i));
+      doNotOptimize (x);
+    });
+  return 0;
+}
@@ -0,0 +1,296 @@
+/****************************************************************************************************/
+/*                                                                                                  */
+/* @module        : Cpp 11 features examples                                                        */
+/* @file          : featureBench.cpp                                                                */
+/* @brief         : Measures what the features shown in src/ cost or save                           */
+/* @input         :                                                                                 */
+/* @outpu         :                                                                                 */
+/* @date          : 16-October-2026                                                                 */
+/* @author        : Pratik Patil                                                                    */
+/* License        :                                                                                 */
+/*               Copyright (C) 2017  Pratik Patil                                                   */
+/*                                                                                                  */
+/*               This program is free software: you can redistribute it and/or modify               */
+/*               it under the terms of the GNU General Public License Version 3 as published by     */
+/*               the Free Software Foundation.                                                      */
+/*                                                                                                  */
+/*               This program is distributed in the hope that it will be useful,                    */
+/*               but WITHOUT ANY WARRANTY; without even the implied warranty of                     */
+/*               MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                      */
+/*               GNU General Public License for more details.                                       */
+/*                                                                                                  */
+/*               You should have received a copy of the GNU General Public License                  */
+/*               along with this program.  If not, see <http://www.gnu.org/licenses/>.              */
+/****************************************************************************************************/
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "benchHarness.h"
+#include "../src/batchBuilder.h"
+#include "../src/lazy.h"
+#include "../src/myString.h"
+#include "../src/objectPool.h"
+
+/*
+ * Description :
+ * One group of benchmarks per demo in src/, named after it:
+ * auto.cpp                        - range for with auto (a copy per element) against const auto&
+ * rvalueReferece.cpp              - myString copy against move, on the heap and in m_local
+ * LambdaExpression.cpp            - std::for_each with a lambda, a function pointer and std::function
+ * initializationSyntax.cpp        - containers built with brace init against push_back / insert
+ * deleted_Default.cpp             - new and delete of a deletedCopyStruct against an objectPool lease
+ * nullptr_delegatingConstructors.cpp - delegating constructor against one doing the work itself,
+ *                                   10000 objects with new against a batchBuilder, lazy<T> get
+ *                                   against std::call_once
+ *
+ * usage : featureBench [--json file] [--reps n] [--warmup ms] [--filter text]
+ */
+
+static long long g_sum = 0;
+
+void
+addToSum (int v)
+{
+  g_sum += v;
+}
+
+struct deletedCopyStruct
+{
+  deletedCopyStruct () = default;
+  deletedCopyStruct &
+  operator = (const deletedCopyStruct &) = delete;
+  deletedCopyStruct (const deletedCopyStruct &) = delete;
+  virtual
+  ~deletedCopyStruct () = default;
+};
+
+class delegatingConstructor
+{
+public:
+  delegatingConstructor () :
+      delegatingConstructor (0)
+  {
+  }
+  delegatingConstructor (int v) :
+      m_value (v), m_twice (2 * v)
+  {
+  }
+  int m_value;
+  int m_twice;
+};
+
+class plainConstructor
+{
+public:
+  plainConstructor () :
+      m_value (0), m_twice (0)
+  {
+  }
+  int m_value;
+  int m_twice;
+};
+
+void
+autoBenchmarks (benchHarness& bench)
+{
+  std::vector<std::string> names (256, std::string (40, 'x'));
+  bench.run ("auto.cpp: for (auto s : strings)", [&]()
+    {
+      size_t n = 0;
+      for (auto s : names)
+	n += s.size ();
+      doNotOptimize (n);
+    });
+  bench.run ("auto.cpp: for (const auto& s : strings)", [&]()
+    {
+      size_t n = 0;
+      for (const auto& s : names)
+	n += s.size ();
+      doNotOptimize (n);
+    });
+}
+
+void
+rvalueBenchmarks (benchHarness& bench)
+{
+  myString heap ("long enough not to fit into m_local of myString");
+  myString local ("short");
+  bench.run ("rvalueReferece.cpp: copy myString", [&]()
+    {
+      myString copy (heap);
+      doNotOptimize (copy);
+    });
+  // moved out and back, so two moves per call
+  bench.run ("rvalueReferece.cpp: move myString x2", [&]()
+    {
+      myString moved (std::move (heap));
+      doNotOptimize (moved);
+      heap = std::move (moved);
+    });
+  bench.run ("rvalueReferece.cpp: copy short myString", [&]()
+    {
+      myString copy (local);
+      doNotOptimize (copy);
+    });
+  bench.run ("rvalueReferece.cpp: move short myString x2", [&]()
+    {
+      myString moved (std::move (local));
+      doNotOptimize (moved);
+      local = std::move (moved);
+    });
+}
+
+void
+lambdaBenchmarks (benchHarness& bench)
+{
+  std::vector<int> values (4096);
+  for (size_t i = 0; i < values.size (); ++i)
+    values[i] = int (i % 97);
+  bench.run ("LambdaExpression.cpp: for_each lambda", [&]()
+    {
+      long long sum = 0;
+      std::for_each (values.begin (), values.end (), [&sum](int v)
+	{ sum += v;});
+      doNotOptimize (sum);
+    });
+  void (*volatile pointer) (int) = addToSum; // volatile: the call can't be resolved at compile time
+  bench.run ("LambdaExpression.cpp: for_each function pointer", [&]()
+    {
+      std::for_each (values.begin (), values.end (), pointer);
+      doNotOptimize (g_sum);
+    });
+  long long sum = 0;
+  std::function<void
+  (int)> function = [&sum](int v)
+    { sum += v;};
+  bench.run ("LambdaExpression.cpp: for_each std::function", [&]()
+    {
+      std::for_each (values.begin (), values.end (), function);
+      doNotOptimize (sum);
+    });
+}
+
+void
+initializationBenchmarks (benchHarness& bench)
+{
+  bench.run ("initializationSyntax.cpp: vector brace init", []()
+    {
+      std::vector<int> v
+	{ 1, 2, 3, 4, 5, 6, 7, 8 };
+      doNotOptimize (v.data ());
+      clobberMemory ();
+    });
+  bench.run ("initializationSyntax.cpp: vector push_back", []()
+    {
+      std::vector<int> v;
+      for (int i = 1; i <= 8; ++i)
+	v.push_back (i);
+      doNotOptimize (v.data ());
+      clobberMemory ();
+    });
+  bench.run ("initializationSyntax.cpp: vector reserve+push_back", []()
+    {
+      std::vector<int> v;
+      v.reserve (8);
+      for (int i = 1; i <= 8; ++i)
+	v.push_back (i);
+      doNotOptimize (v.data ());
+      clobberMemory ();
+    });
+  bench.run ("initializationSyntax.cpp: map brace init", []()
+    {
+      std::map<int, int> m
+	{
+	  { 1, 10 },
+	  { 2, 20 },
+	  { 3, 30 },
+	  { 4, 40 } };
+      doNotOptimize (m);
+    });
+  bench.run ("initializationSyntax.cpp: map insert", []()
+    {
+      std::map<int, int> m;
+      for (int i = 1; i <= 4; ++i)
+	m.insert (std::make_pair (i, i * 10));
+      doNotOptimize (m);
+    });
+}
+
+void
+deletedDefaultBenchmarks (benchHarness& bench)
+{
+  bench.run ("deleted_Default.cpp: new/delete", []()
+    {
+      deletedCopyStruct* d = new deletedCopyStruct;
+      doNotOptimize (d);
+      delete d;
+    });
+  objectPool<deletedCopyStruct> pool;
+  bench.run ("deleted_Default.cpp: objectPool lease", [&]()
+    {
+      objectPool<deletedCopyStruct>::lease d = pool.acquire ();
+      doNotOptimize (d);
+    });
+}
+
+void
+delegatingBenchmarks (benchHarness& bench)
+{
+  bench.run ("nullptr_delegatingConstructors.cpp: delegating", []()
+    {
+      delegatingConstructor d;
+      doNotOptimize (d);
+    });
+  bench.run ("nullptr_delegatingConstructors.cpp: plain", []()
+    {
+      plainConstructor p;
+      doNotOptimize (p);
+    });
+  bench.run ("nullptr_delegatingConstructors.cpp: 10000 x new", []()
+    {
+      std::vector<std::unique_ptr<delegatingConstructor>> nodes;
+      nodes.reserve (10000);
+      for (int i = 0; i < 10000; ++i)
+	nodes.emplace_back (new delegatingConstructor (i));
+      doNotOptimize (nodes.back ()->m_value);
+    });
+  bench.run ("nullptr_delegatingConstructors.cpp: batchBuilder", []()
+    {
+      batchBuilder<delegatingConstructor> nodes;
+      nodes.generate (10000, [](size_t i)
+	{ return delegatingConstructor (int (i));});
+      doNotOptimize (nodes[9999].m_value);
+    });
+  lazy<delegatingConstructor> later ([]()
+    { return delegatingConstructor (42);});
+  bench.run ("nullptr_delegatingConstructors.cpp: lazy get", [&]()
+    {
+      doNotOptimize (later->m_value);
+    });
+  std::once_flag once;
+  delegatingConstructor* onceObject = nullptr;
+  bench.run ("nullptr_delegatingConstructors.cpp: call_once get", [&]()
+    {
+      std::call_once (once, [&]()
+	{ onceObject = new delegatingConstructor (42);});
+      doNotOptimize (onceObject->m_value);
+    });
+  delete onceObject;
+}
+
+int
+main (int argc, char* argv[])
+{
+  benchHarness bench (argc, argv);
+  autoBenchmarks (bench);
+  rvalueBenchmarks (bench);
+  lambdaBenchmarks (bench);
+  initializationBenchmarks (bench);
+  deletedDefaultBenchmarks (bench);
+  delegatingBenchmarks (bench);
+  return 0;
+}
@@ -0,0 +1,103 @@
+/****************************************************************************************************/
+/*                                                                                                  */
+/* @module        : Cpp 11 features examples                                                        */
+/* @file          : flatHashMapBench.cpp                                                            */
+/* @brief         : Insert, lookup and iteration of flatHashMap against std::map/unordered_map      */
+/* @input         :                                                                                 */
+/* @outpu         :                                                                                 */
+/* @date          : 16-October-2026                                                                 */
+/* @author        : Pratik Patil                                                                    */
+/* License        :                                                                                 */
+/*               Copyright (C) 2017  Pratik Patil                                                   */
+/*                                                                                                  */
+/*               This program is free software: you can redistribute it and/or modify               */
+/*               it under the terms of the GNU General Public License Version 3 as published by     */
+/*               the Free Software Foundation.                                                      */
+/*                                                                                                  */
+/*               This program is distributed in the hope that it will be useful,                    */
+/*               but WITHOUT ANY WARRANTY; without even the implied warranty of                     */
+/*               MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                      */
+/*               GNU General Public License for more details.                                       */
+/*                                                                                                  */
+/*               You should have received a copy of the GNU General Public License                  */
+/*               along with this program.  If not, see <http://www.gnu.org/licenses/>.              */
+/****************************************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include "benchHarness.h"
+#include "../src/flatHashMap.h"
+
+/*
+ * Description :
+ * A name -> phone number table like the singers map of initializationSyntax.cpp, with n entries.
+ * Measures building it, looking up every name (in a different order than inserted) and
+ * iterating over it by reference. Each row is followed by ns per entry of its median; inserting
+ * starts from an empty map, cleared untimed before every run.
+ *
+ * usage : flatHashMapBench [n, default 10^6] [benchHarness options]
+ * build : make benches
+ */
+
+void
+perEntry (const benchResult* r, size_t n)
+{
+  if (r)
+    std::cout << "    " << r->percentile (50) / n << " ns per entry" << std::endl;
+}
+
+template<class MAP>
+  void
+  run (benchHarness& bench, const std::string& name, const std::vector<std::string>& names,
+       const std::vector<size_t>& order)
+  {
+    MAP map;
+    auto insert = [&]()
+      {
+	for (const std::string& n : names)
+	  map.insert (std::make_pair (n, "+1 (212) 555-" + n.substr (n.size () - 4)));
+      };
+    perEntry (bench.run (name + " insert", [&]()
+      { map.clear ();}, insert), names.size ());
+    if (map.empty ())
+      insert ();
+    perEntry (bench.run (name + " lookup", [&]()
+      {
+	size_t sum = 0;
+	for (size_t i : order)
+	  sum += map.find (names[i])->second.size ();
+	doNotOptimize (sum);
+      }), names.size ());
+    perEntry (bench.run (name + " iterate", [&]()
+      {
+	size_t sum = 0;
+	for (const auto& entry : map)
+	  sum += entry.second.size ();
+	doNotOptimize (sum);
+      }), names.size ());
+  }
+
+int
+main (int argc, char* argv[])
+{
+  benchHarness bench (argc, argv, 10);
+  size_t n = bench.argument (0, 1000000);
+  std::vector<std::string> names;
+  std::vector<size_t> order;
+  unsigned seed = 1;
+  for (size_t i = 0; i < n; ++i)
+    {
+      names.push_back ("singer number " + std::to_string (i * 7919 % 1000003 + 10000));
+      seed = seed * 1103515245 + 12345;
+      order.push_back (seed % n);
+    }
+
+  std::cout << n << " entries" << std::endl;
+  run<std::map<std::string, std::string> > (bench, "std::map", names, order);
+  run<std::unordered_map<std::string, std::string> > (bench, "std::unordered_map", names, order);
+  run<flatHashMap<std::string, std::string> > (bench, "flatHashMap", names, order);
+  return 0;
+}
@@ -0,0 +1,195 @@
+/****************************************************************************************************/
+/*                                                                                                  */
+/* @module        : Cpp 11 features examples                                                        */
+/* @file          : internPoolBench.cpp                                                             */
+/* @brief         : myString keys against internedString handles                                    */
+/* @input         :                                                                                 */
+/* @outpu         :                                                                                 */
+/* @date          : 16-October-2026                                                                 */
+/* @author        : Pratik Patil                                                                    */
+/* License        :                                                                                 */
+/*               Copyright (C) 2017  Pratik Patil                                                   */
+/*                                                                                                  */
+/*               This program is free software: you can redistribute it and/or modify               */
+/*               it under the terms of the GNU General Public License Version 3 as published by     */
+/*               the Free Software Foundation.                                                      */
+/*                                                                                                  */
+/*               This program is distributed in the hope that it will be useful,                    */
+/*               but WITHOUT ANY WARRANTY; without even the implied warranty of                     */
+/*               MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                      */
+/*               GNU General Public License for more details.                                       */
+/*                                                                                                  */
+/*               You should have received a copy of the GNU General Public License                  */
+/*               along with this program.  If not, see <http://www.gnu.org/licenses/>.              */
+/****************************************************************************************************/
+#include <iostream>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include "benchHarness.h"
+#include "../src/flatHashMap.h"
+#include "../src/internPool.h"
+#include "../src/myString.h"
+
+/*
+ * Description :
+ * A call log of n entries naming one of 1000 singers ("Singer Firstname Lastname #i", longer
+ * than the myString local buffer), kept:
+ * - as a vector<myString>, one heap copy per entry,
+ * - as a vector<internedString> over an internPool.
+ * Compares memory, building the log, counting the entries equal to one name and summing a
+ * per singer value through a flatHashMap keyed by each, then interns the log from 1, 2, 4 and 8
+ * threads at once, printed as M/s from the median.
+ *
+ * usage : internPoolBench [n, default 1000000] [benchHarness options]
+ * build : make benches
+ */
+
+struct myStringHash
+{
+  size_t
+  operator () (const myString& s) const
+  {
+    size_t h = 14695981039346656037ULL;
+    for (size_t i = 0, n = s.length (); i < n; ++i)
+      h = (h ^ (unsigned char) s.m_data[i]) * 1099511628211ULL;
+    return h;
+  }
+};
+
+struct myStringEqual
+{
+  bool
+  operator () (const myString& a, const myString& b) const
+  {
+    return a.length () == b.length () && !memcmp (a.m_data, b.m_data, a.length ());
+  }
+};
+
+int
+main (int argc, char* argv[])
+{
+  benchHarness bench (argc, argv, 10);
+  size_t n = bench.argument (0, 1000000);
+  const size_t singers = 1000;
+  std::vector<std::string> names;
+  for (size_t i = 0; i < singers; ++i)
+    names.push_back ("Singer Firstname Lastname #" + std::to_string (i));
+  std::vector<size_t> pick (n);
+  for (size_t i = 0; i < n; ++i)
+    pick[i] = (i * 2654435761u) % singers;
+
+  auto buildStrings = [&]()
+    {
+      std::vector<myString> log;
+      log.reserve (n);
+      for (size_t i = 0; i < n; ++i)
+	log.emplace_back (names[pick[i]].c_str ());
+      return log;
+    };
+  internPool pool;
+  auto buildHandles = [&]()
+    {
+      std::vector<internedString> log;
+      log.reserve (n);
+      for (size_t i = 0; i < n; ++i)
+	log.push_back (pool.intern (names[pick[i]]));
+      return log;
+    };
+  std::vector<myString> strings = buildStrings ();
+  std::vector<internedString> handles = buildHandles ();
+
+  size_t stringBytes = n * sizeof(myString);
+  for (const myString& s : strings)
+    stringBytes += s.length () + 1 > myString::s_localCapacity ? s.length () + 1 : 0;
+  internStats stats = pool.stats ();
+  size_t handleBytes = n * sizeof(internedString) + stats.bytesStored;
+  std::cout << n << " entries, " << stats.unique << " unique" << std::endl;
+  std::cout << "memory : myString " << stringBytes / 1024 << " KB, interned " << handleBytes / 1024
+      << " KB" << std::endl;
+
+  bench.run ("build myString", [&]()
+    {
+      doNotOptimize (buildStrings ());
+    });
+  bench.run ("build interned", [&]()
+    {
+      doNotOptimize (buildHandles ());
+    });
+
+  myString wantedString (names[7].c_str ());
+  internedString wantedHandle = pool.intern (names[7]);
+  myStringEqual equal;
+  auto countStrings = [&]()
+    {
+      return std::count_if (strings.begin (), strings.end (), [&](const myString& s)
+	{ return equal (s, wantedString);});
+    };
+  auto countHandles = [&]()
+    {
+      return std::count (handles.begin (), handles.end (), wantedHandle);
+    };
+  bench.run ("equal myString", [&]()
+    {
+      doNotOptimize (countStrings ());
+    });
+  bench.run ("equal interned", [&]()
+    {
+      doNotOptimize (countHandles ());
+    });
+
+  flatHashMap<myString, size_t, myStringHash, myStringEqual> byString;
+  flatHashMap<internedString, size_t, internedStringHash> byHandle;
+  for (size_t i = 0; i < singers; ++i)
+    {
+      byString.emplace (myString (names[i].c_str ()), i);
+      byHandle.emplace (pool.intern (names[i]), i);
+    }
+  auto sumStrings = [&]()
+    {
+      size_t sum = 0;
+      for (const myString& s : strings)
+	sum += byString.find (s)->second;
+      return sum;
+    };
+  auto sumHandles = [&]()
+    {
+      size_t sum = 0;
+      for (internedString h : handles)
+	sum += byHandle.find (h)->second;
+      return sum;
+    };
+  bench.run ("lookup myString", [&]()
+    {
+      doNotOptimize (sumStrings ());
+    });
+  bench.run ("lookup interned", [&]()
+    {
+      doNotOptimize (sumHandles ());
+    });
+  if (countStrings () != countHandles () || sumStrings () != sumHandles ())
+    std::cout << "results differ" << std::endl;
+
+  for (unsigned threads : { 1u, 2u, 4u, 8u })
+    {
+      const benchResult* r = bench.run ("intern " + std::to_string (threads) + " threads", [&]()
+	{
+	  internPool shared;
+	  std::vector<std::thread> workers;
+	  for (unsigned t = 0; t < threads; ++t)
+	    workers.emplace_back ([&, t]()
+	      {
+		for (size_t i = t; i < n; i += threads)
+		  shared.intern (names[pick[i]]);
+	      });
+	  for (std::thread& w : workers)
+	    w.join ();
+	});
+      if (r)
+	std::cout << "    " << n / r->percentile (50) * 1000 << " M/s" << std::endl;
+    }
+  return 0;
+}
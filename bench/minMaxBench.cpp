@@ -0,0 +1,101 @@
+/****************************************************************************************************/
+/*                                                                                                  */
+/* @module        : Cpp 11 features examples                                                        */
+/* @file          : minMaxBench.cpp                                                                 */
+/* @brief         : Scaling of minMax over thread count for int, float and double arrays            */
+/* @input         :                                                                                 */
+/* @outpu         :                                                                                 */
+/* @date          : 16-October-2026                                                                 */
+/* @author        : Pratik Patil                                                                    */
+/* License        :                                                                                 */
+/*               Copyright (C) 2017  Pratik Patil                                                   */
+/*                                                                                                  */
+/*               This program is free software: you can redistribute it and/or modify               */
+/*               it under the terms of the GNU General Public License Version 3 as published by     */
+/*               the Free Software Foundation.                                                      */
+/*                                                                                                  */
+/*               This program is distributed in the hope that it will be useful,                    */
+/*               but WITHOUT ANY WARRANTY; without even the implied warranty of                     */
+/*               MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                      */
+/*               GNU General Public License for more details.                                       */
+/*                                                                                                  */
+/*               You should have received a copy of the GNU General Public License                  */
+/*               along with this program.  If not, see <http://www.gnu.org/licenses/>.              */
+/****************************************************************************************************/
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include "benchHarness.h"
+#include "../src/minMax.h"
+
+/*
+ * Description :
+ * Times minMax on n elements of int, float and double on pools of 1, 2, 4 ... worker threads up
+ * to the number of cores, next to the scalar for_each/lambda loop findMinMax used to do. After each minMax row
+ * the median is printed as GB/s and as speedup over the scalar loop.
+ *
+ * usage : minMaxBench [n, default 10^8] [max threads] [benchHarness options]
+ * build : make benches
+ */
+
+template<class T>
+  void
+  run (benchHarness& bench, const std::string& name, size_t n, unsigned maxThreads)
+  {
+    std::vector<T> data (n);
+    unsigned seed = 12345;
+    for (T& v : data)
+      {
+	seed = seed * 1103515245 + 12345;
+	v = T (int (seed >> 8) - (1 << 22));
+      }
+
+    const benchResult* scalar = bench.run (name + " scalar lambda", [&]()
+      {
+	T min = data[0];
+	T max = data[0];
+	std::for_each (data.begin (), data.end (), [&min, &max] (T a)
+	  {
+	    if (min > a)
+	      min = a;
+	    if (max < a)
+	      max = a;
+	  });
+	doNotOptimize (min);
+	doNotOptimize (max);
+      });
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2)
+      {
+	threadPool pool (threads);
+	std::string label = name + " minMax " + std::to_string (threads) + " threads";
+	const benchResult* r = bench.run (label, [&]()
+	  {
+	    minMaxResult<T> m = minMax (data.data (), n, pool);
+	    doNotOptimize (m);
+	  });
+	if (!r)
+	  continue;
+	double ns = r->percentile (50);
+	std::cout << "    " << n * sizeof(T) / ns << " GB/s";
+	if (scalar)
+	  std::cout << ", x" << scalar->percentile (50) / ns;
+	std::cout << std::endl;
+      }
+  }
+
+int
+main (int argc, char* argv[])
+{
+  benchHarness bench (argc, argv, 5);
+  size_t n = bench.argument (0, 100000000);
+  unsigned maxThreads = bench.argument (1, std::thread::hardware_concurrency ());
+  if (maxThreads == 0)
+    maxThreads = 1;
+
+  run<int> (bench, "int", n, maxThreads);
+  run<float> (bench, "float", n, maxThreads);
+  run<double> (bench, "double", n, maxThreads);
+  return 0;
+}
@@ -0,0 +1,117 @@
+/****************************************************************************************************/
+/*                                                                                                  */
+/* @module        : Cpp 11 features examples                                                        */
+/* @file          : myStringAllocatorBench.cpp                                                      */
+/* @brief         : Compares allocation policies of basicMyString under several threads             */
+/* @input         :                                                                                 */
+/* @outpu         :                                                                                 */
+/* @date          : 16-October-2026                                                                 */
+/* @author        : Pratik Patil                                                                    */
+/* License        :                                                                                 */
+/*               Copyright (C) 2017  Pratik Patil                                                   */
+/*                                                                                                  */
+/*               This program is free software: you can redistribute it and/or modify               */
+/*               it under the terms of the GNU General Public License Version 3 as published by     */
+/*               the Free Software Foundation.                                                      */
+/*                                                                                                  */
+/*               This program is distributed in the hope that it will be useful,                    */
+/*               but WITHOUT ANY WARRANTY; without even the implied warranty of                     */
+/*               MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                      */
+/*               GNU General Public License for more details.                                       */
+/*                                                                                                  */
+/*               You should have received a copy of the GNU General Public License                  */
+/*               along with this program.  If not, see <http://www.gnu.org/licenses/>.              */
+/****************************************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+#include "benchHarness.h"
+#include "../src/myString.h"
+
+/*
+ * Description :
+ * Every thread serves a number of "requests". A request builds a batch of strings of mixed length
+ * (most of them too long for the inline buffer) by concatenation, keeps them alive until the
+ * request is done and then drops them all. With arenaString the request owns an arena, which is
+ * reset in one go at the end. Each row is followed by ns per string of its median, the last line
+ * gives the speedups of the medians.
+ *
+ * usage : myStringAllocatorBench [threads] [requests per thread] [benchHarness options]
+ * build : make benches
+ */
+
+static const size_t s_stringsPerRequest = 256;
+
+template<class STRING>
+  size_t
+  serveRequests (size_t requests)
+  {
+    const char* words[] =
+      { "Lady Gaga", "+1 (212) 555-7890", "Beyonce Knowles", "+1 (212) 555-0987" };
+    myStringArena arena;
+    myStringArena::scope requestScope (arena);
+    size_t sink = 0;
+    std::vector<STRING> strings;
+    strings.reserve (s_stringsPerRequest);
+    for (size_t r = 0; r < requests; ++r)
+      {
+	STRING name (words[r & 3]);
+	for (size_t i = 0; i < s_stringsPerRequest; ++i)
+	  {
+	    if (i & 1)
+	      strings.push_back (STRING (words[i & 3]));
+	    else
+	      strings.push_back (STRING (name + " : " + words[(i >> 1) & 3] + " : " + name));
+	  }
+	for (const STRING& s : strings)
+	  sink += s.m_size;
+	strings.clear ();
+	arena.reset ();
+      }
+    return sink;
+  }
+
+template<class STRING>
+  double
+  run (benchHarness& bench, const std::string& name, size_t threads, size_t requests)
+  {
+    const benchResult* r = bench.run (name, [threads, requests]()
+      {
+	std::vector<std::thread> workers;
+	std::vector<size_t> sinks (threads);
+	for (size_t t = 0; t < threads; ++t)
+	  workers.push_back (std::thread ([&sinks, t, requests]()
+	    {
+	      sinks[t] = serveRequests<STRING> (requests);
+	    }));
+	for (std::thread& worker : workers)
+	  worker.join ();
+	doNotOptimize (sinks[0]);
+      });
+    if (!r)
+      return 0;
+    double ns = r->percentile (50) / (threads * requests * s_stringsPerRequest);
+    std::cout << "    " << ns << " ns/string" << std::endl;
+    return ns;
+  }
+
+int
+main (int argc, char* argv[])
+{
+  benchHarness bench (argc, argv, 10);
+  size_t threads = bench.argument (0, std::thread::hardware_concurrency ());
+  size_t requests = bench.argument (1, 2000);
+  if (threads == 0)
+    threads = 1;
+
+  std::cout << threads << " threads, " << requests << " requests per thread" << std::endl;
+  double heap = run<myString> (bench, "new[]/delete[]", threads, requests);
+  double pool = run<poolString> (bench, "size class pool", threads, requests);
+  double arena = run<arenaString> (bench, "request arena", threads, requests);
+  if (heap && pool && arena)
+    std::cout << "speedup pool : " << heap / pool << "x, arena : " << heap / arena << "x"
+	<< std::endl;
+  return 0;
+}
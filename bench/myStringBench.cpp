@@ -0,0 +1,234 @@
+/****************************************************************************************************/
+/*                                                                                                  */
+/* @module        : Cpp 11 features examples                                                        */
+/* @file          : myStringBench.cpp                                                               */
+/* @brief         : Allocation count and ns/op of myString against the old heap only version        */
+/* @input         :                                                                                 */
+/* @outpu         :                                                                                 */
+/* @date          : 16-October-2026                                                                 */
+/* @author        : Pratik Patil                                                                    */
+/* License        :                                                                                 */
+/*               Copyright (C) 2017  Pratik Patil                                                   */
+/*                                                                                                  */
+/*               This program is free software: you can redistribute it and/or modify               */
+/*               it under the terms of the GNU General Public License Version 3 as published by     */
+/*               the Free Software Foundation.                                                      */
+/*                                                                                                  */
+/*               This program is distributed in the hope that it will be useful,                    */
+/*               but WITHOUT ANY WARRANTY; without even the implied warranty of                     */
+/*               MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                      */
+/*               GNU General Public License for more details.                                       */
+/*                                                                                                  */
+/*               You should have received a copy of the GNU General Public License                  */
+/*               along with this program.  If not, see <http://www.gnu.org/licenses/>.              */
+/****************************************************************************************************/
+#include <iostream>
+#include <cstring>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include "benchHarness.h"
+#include "../src/myString.h"
+
+/*
+ * Description :
+ * Compares myString with legacyString, a copy of myString as it was before small string
+ * optimization, assignment operators and concatenation expressions were added (every construction
+ * calls new[], assignment goes through copy/move construction of a temporary and swap, every +
+ * allocates a new temporary).
+ * The trace messages legacyString used to print are left out, the comparison is about allocations.
+ *
+ * Global operator new[] is replaced to count allocations. Each pair of rows is followed by the
+ * allocations per call, counted over untimed calls.
+ *
+ * usage : myStringBench [benchHarness options]
+ * build : make benches
+ */
+
+static size_t g_allocations = 0;
+
+// noinline (new[] and delete[]): once inlined, gcc sees free on memory from new[] or delete[] on
+// memory from malloc and warns (-Wmismatched-new-delete)
+void* __attribute__((noinline))
+operator new[] (size_t size)
+{
+  ++g_allocations;
+  void* p = malloc (size ? size : 1);
+  if (!p)
+    throw std::bad_alloc ();
+  return p;
+}
+
+void __attribute__((noinline))
+operator delete[] (void* p) noexcept
+{
+  free (p);
+}
+
+void __attribute__((noinline))
+operator delete[] (void* p, size_t) noexcept
+{
+  free (p);
+}
+
+class legacyString
+{
+public:
+  char* m_data;
+  size_t m_size;
+  legacyString () :
+      m_data (nullptr), m_size (0)
+  {
+  }
+  legacyString (const char* ptr)
+  {
+    m_size = strlen (ptr) + 1;
+    m_data = new char[m_size];
+    memcpy (m_data, ptr, m_size);
+  }
+  ~legacyString ()
+  {
+    delete[] m_data;
+  }
+  legacyString (const legacyString& str)
+  {
+    m_size = str.m_size;
+    m_data = new char[m_size];
+    memcpy (m_data, str.m_data, m_size);
+  }
+  legacyString (legacyString&& str)
+  {
+    m_data = str.m_data;
+    m_size = str.m_size;
+    str.m_data = nullptr;
+  }
+  legacyString
+  operator + (const legacyString& str)
+  {
+    legacyString temp;
+    temp.m_size = this->m_size + str.m_size - 1;
+    temp.m_data = new char[temp.m_size];
+    memcpy (temp.m_data, this->m_data, this->m_size);
+    memcpy (temp.m_data + this->m_size - 1, str.m_data, str.m_size);
+    return temp;
+  }
+  // There was no assignment operator, reassigning meant building a new object and swapping.
+  void
+  swap (legacyString& str)
+  {
+    std::swap (m_data, str.m_data);
+    std::swap (m_size, str.m_size);
+  }
+};
+
+///
+/// Allocations per call of body, counted over untimed calls
+///
+template<class BODY>
+  double
+  allocationsPerCall (BODY& body)
+  {
+    const size_t calls = 100;
+    size_t allocations = g_allocations;
+    for (size_t i = 0; i < calls; ++i)
+      body ();
+    return double (g_allocations - allocations) / calls;
+  }
+
+///
+/// Times the legacyString and the myString version of one operation
+///
+template<class BEFORE, class AFTER>
+  void
+  compare (benchHarness& bench, const std::string& name, BEFORE before, AFTER after)
+  {
+    bench.run (name + ": legacyString", before);
+    bench.run (name + ": myString", after);
+    std::cout << "    allocations per call : legacyString " << allocationsPerCall (before)
+	<< ", myString " << allocationsPerCall (after) << std::endl;
+  }
+
+int
+main (int argc, char* argv[])
+{
+  benchHarness bench (argc, argv);
+  const char* keys[] =
+    { "This is data", "short key", "user:42", "Lady Gaga" };
+  const char* longText = "This is data.. And this is appended later, long enough for the heap";
+  size_t i = 0; // varies the input from call to call
+
+  compare (bench, "construct + copy short string", [&]()
+    {
+      legacyString s (keys[++i & 3]);
+      legacyString c (s);
+      doNotOptimize (c.m_size);
+    }, [&]()
+    {
+      myString s (keys[++i & 3]);
+      myString c (s);
+      doNotOptimize (c.m_size);
+    });
+
+  legacyString legacyTarget (longText);
+  myString target (longText);
+  myString sources[] =
+    { keys[1], longText };
+  compare (bench, "reassign existing string", [&]()
+    {
+      ++i;
+      legacyString tmp (i & 1 ? keys[i & 3] : longText);
+      legacyTarget.swap (tmp);
+      doNotOptimize (legacyTarget.m_size);
+    }, [&]()
+    {
+      target = sources[++i & 1];
+      doNotOptimize (target.m_size);
+    });
+
+  compare (bench, "construct + move long string", [&]()
+    {
+      legacyString s (longText);
+      legacyString m (std::move (s));
+      doNotOptimize (m.m_size);
+    }, [&]()
+    {
+      myString s (longText);
+      myString m (std::move (s));
+      doNotOptimize (m.m_size);
+    });
+
+  legacyString legacyPieces[] =
+    { "2017-09-17 10:00:00", " [info] ", "rvalueReference", ": ", longText, "\n" };
+  myString pieces[] =
+    { "2017-09-17 10:00:00", " [info] ", "rvalueReference", ": ", longText, "\n" };
+  compare (bench, "concatenate 6 pieces", [&]()
+    {
+      legacyString line = legacyPieces[0] + legacyPieces[1] + legacyPieces[2] + legacyPieces[3]
+	  + legacyPieces[4] + legacyPieces[5];
+      doNotOptimize (line.m_size);
+    }, [&]()
+    {
+      myString line = pieces[0] + pieces[1] + pieces[2] + pieces[3] + pieces[4] + pieces[5];
+      doNotOptimize (line.m_size);
+    });
+
+  const int appends = 4096;
+  compare (bench, "build string from 4096 appends", [&]()
+    {
+      legacyString built ("");
+      for (int a = 0; a < appends; ++a)
+	{
+	  legacyString next = built + legacyPieces[1];
+	  built.swap (next);
+	}
+      doNotOptimize (built.m_size);
+    }, [&]()
+    {
+      myStringBuilder builder;
+      for (int a = 0; a < appends; ++a)
+	builder.append (pieces[1]);
+      myString built (builder.release ());
+      doNotOptimize (built.m_size);
+    });
+  return 0;
+}
@@ -0,0 +1,107 @@
+/****************************************************************************************************/
+/*                                                                                                  */
+/* @module        : Cpp 11 features examples                                                        */
+/* @file          : outputBufferBench.cpp                                                           */
+/* @brief         : Writing records with ostream, stdio and outputBuffer                            */
+/* @input         :                                                                                 */
+/* @outpu         :                                                                                 */
+/* @date          : 16-October-2026                                                                 */
+/* @author        : Pratik Patil                                                                    */
+/* License        :                                                                                 */
+/*               Copyright (C) 2017  Pratik Patil                                                   */
+/*                                                                                                  */
+/*               This program is free software: you can redistribute it and/or modify               */
+/*               it under the terms of the GNU General Public License Version 3 as published by     */
+/*               the Free Software Foundation.                                                      */
+/*                                                                                                  */
+/*               This program is distributed in the hope that it will be useful,                    */
+/*               but WITHOUT ANY WARRANTY; without even the implied warranty of                     */
+/*               MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                      */
+/*               GNU General Public License for more details.                                       */
+/*                                                                                                  */
+/*               You should have received a copy of the GNU General Public License                  */
+/*               along with this program.  If not, see <http://www.gnu.org/licenses/>.              */
+/****************************************************************************************************/
+#include <iostream>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <fcntl.h>
+#include <unistd.h>
+#include "benchHarness.h"
+#include "../src/outputBuffer.h"
+
+/*
+ * Description :
+ * Writes n records "index<TAB>value<TAB>ratio" (two integers and a double) to a temporary file:
+ * - std::ofstream with std::endl, the way the demo loops wrote to std::cout,
+ * - std::ofstream with '\n',
+ * - fprintf,
+ * - outputBuffer writing with write (2),
+ * - outputBuffer handing its buffers to the writer thread.
+ * Each row is followed by its median in ns per record.
+ *
+ * usage : outputBufferBench [n, default 2000000] [benchHarness options]
+ * build : make benches
+ */
+
+void
+perRecord (const benchResult* r, long n)
+{
+  if (r)
+    std::cout << "    " << r->percentile (50) / n << " ns per record" << std::endl;
+}
+
+int
+main (int argc, char* argv[])
+{
+  benchHarness bench (argc, argv, 5);
+  long n = bench.argument (0, 2000000);
+  char path[] = "/tmp/outputBufferBenchXXXXXX";
+  int fd = mkstemp (path);
+  if (fd < 0)
+    {
+      std::cout << "can't create a temporary file" << std::endl;
+      return 1;
+    }
+  close (fd);
+
+  std::cout << n << " records" << std::endl;
+  perRecord (bench.run ("ofstream, endl", [&]()
+    {
+      std::ofstream out (path);
+      for (long i = 0; i < n; ++i)
+	out << i << '\t' << i * 7919 % 100003 << '\t' << i / 7.0 << std::endl;
+    }), n);
+  perRecord (bench.run ("ofstream, '\\n'", [&]()
+    {
+      std::ofstream out (path);
+      for (long i = 0; i < n; ++i)
+	out << i << '\t' << i * 7919 % 100003 << '\t' << i / 7.0 << '\n';
+    }), n);
+  perRecord (bench.run ("fprintf", [&]()
+    {
+      FILE* out = fopen (path, "w");
+      for (long i = 0; i < n; ++i)
+	fprintf (out, "%ld\t%ld\t%g\n", i, i * 7919 % 100003, i / 7.0);
+      fclose (out);
+    }), n);
+  auto buffered = [&](bool async)
+    {
+      return [&, async]()
+	{
+	  int out = open (path, O_WRONLY | O_TRUNC);
+	    {
+	      outputBuffer buffer (out, outputBuffer::s_defaultCapacity, async);
+	      for (long i = 0; i < n; ++i)
+		buffer << i << '\t' << i * 7919 % 100003 << '\t' << i / 7.0 << '\n';
+	    }
+	  close (out);
+	};
+    };
+  perRecord (bench.run ("outputBuffer", buffered (false)), n);
+  perRecord (bench.run ("outputBuffer async", buffered (true)), n);
+  unlink (path);
+  return 0;
+}
@@ -0,0 +1,214 @@
+/****************************************************************************************************/
+/*                                                                                                  */
+/* @module        : Cpp 11 features examples                                                        */
+/* @file          : ringQueueBench.cpp                                                              */
+/* @brief         : ringQueue against a mutex guarded std::queue                                    */
+/* @input         :                                                                                 */
+/* @outpu         :                                                                                 */
+/* @date          : 16-October-2026                                                                 */
+/* @author        : Pratik Patil                                                                    */
+/* License        :                                                                                 */
+/*               Copyright (C) 2017  Pratik Patil                                                   */
+/*                                                                                                  */
+/*               This program is free software: you can redistribute it and/or modify               */
+/*               it under the terms of the GNU General Public License Version 3 as published by     */
+/*               the Free Software Foundation.                                                      */
+/*                                                                                                  */
+/*               This program is distributed in the hope that it will be useful,                    */
+/*               but WITHOUT ANY WARRANTY; without even the implied warranty of                     */
+/*               MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                      */
+/*               GNU General Public License for more details.                                       */
+/*                                                                                                  */
+/*               You should have received a copy of the GNU General Public License                  */
+/*               along with this program.  If not, see <http://www.gnu.org/licenses/>.              */
+/****************************************************************************************************/
+#include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+#include "benchHarness.h"
+#include "../src/myString.h"
+#include "../src/ringQueue.h"
+
+/*
+ * Description :
+ * 1 to N producer/consumer pairs hand n myStrings each (long enough to live on the heap) from the
+ * producers to the consumers:
+ * - through a std::queue guarded by a std::mutex,
+ * - through a ringQueue of 1024 slots, one element per push / pop,
+ * - through the same ringQueue, s_batch elements per tryPushBatch / tryPopBatch.
+ * Each row is followed by its median as M elements/s. Then one pair bounces a counter through two
+ * ringQueues and reports the round trip time.
+ *
+ * usage : ringQueueBench [n, default 1000000] [N pairs, default 4] [benchHarness options]
+ * build : make benches
+ */
+
+static const size_t s_batch = 32;
+static const char s_text[] = "a string long enough for the heap";
+
+class mutexQueue
+{
+public:
+  bool
+  tryPush (myString&& value)
+  {
+    std::lock_guard<std::mutex> lock (m_mutex);
+    m_queue.push (std::move (value));
+    return true;
+  }
+  bool
+  tryPop (myString& value)
+  {
+    std::lock_guard<std::mutex> lock (m_mutex);
+    if (m_queue.empty ())
+      return false;
+    value = std::move (m_queue.front ());
+    m_queue.pop ();
+    return true;
+  }
+
+private:
+  std::mutex m_mutex;
+  std::queue<myString> m_queue;
+};
+
+template<class QUEUE>
+  void
+  produceOne (QUEUE& queue, size_t n)
+  {
+    for (size_t i = 0; i < n; ++i)
+      {
+	myString s (s_text);
+	while (!queue.tryPush (std::move (s)))
+	  std::this_thread::yield ();
+      }
+  }
+
+template<class QUEUE>
+  void
+  consumeOne (QUEUE& queue, size_t n)
+  {
+    myString s;
+    for (size_t i = 0; i < n; ++i)
+      while (!queue.tryPop (s))
+	std::this_thread::yield ();
+  }
+
+void
+produceBatch (ringQueue<myString>& queue, size_t n)
+{
+  std::vector<myString> batch (s_batch);
+  for (size_t i = 0; i < n; i += s_batch)
+    {
+      size_t count = std::min (s_batch, n - i);
+      for (size_t j = 0; j < count; ++j)
+	batch[j] = myString (s_text);
+      for (size_t done = 0; done < count;)
+	{
+	  size_t pushed = queue.tryPushBatch (batch.begin () + done, count - done);
+	  if (!pushed)
+	    std::this_thread::yield ();
+	  done += pushed;
+	}
+    }
+}
+
+void
+consumeBatch (ringQueue<myString>& queue, size_t n)
+{
+  std::vector<myString> batch (s_batch);
+  for (size_t i = 0; i < n;)
+    {
+      size_t popped = queue.tryPopBatch (batch.begin (), std::min (s_batch, n - i));
+      if (!popped)
+	std::this_thread::yield ();
+      i += popped;
+    }
+}
+
+///
+/// Runs pairs producers and consumers over one queue, each handing n elements, and prints the
+/// throughput of the median
+///
+template<class QUEUE, class BASE>
+  void
+  runPairs (benchHarness& bench, const std::string& name, unsigned pairs, size_t n, void
+  (*produce) (BASE&, size_t), void
+  (*consume) (BASE&, size_t))
+  {
+    const benchResult* r = bench.run (std::to_string (pairs) + " pairs " + name, [&]()
+      {
+	QUEUE queue;
+	std::vector<std::thread> threads;
+	for (unsigned p = 0; p < pairs; ++p)
+	  {
+	    threads.emplace_back (produce, std::ref<BASE> (queue), n);
+	    threads.emplace_back (consume, std::ref<BASE> (queue), n);
+	  }
+	for (std::thread& t : threads)
+	  t.join ();
+      });
+    if (r)
+      std::cout << "    " << double (n) * pairs / r->percentile (50) * 1000 << " M/s" << std::endl;
+  }
+
+struct ring : ringQueue<myString>
+{
+  ring () :
+      ringQueue<myString> (1024)
+  {
+  }
+};
+
+int
+main (int argc, char* argv[])
+{
+  benchHarness bench (argc, argv, 5);
+  size_t n = bench.argument (0, 1000000);
+  unsigned maxPairs = bench.argument (1, 4);
+
+  std::cout << n << " myStrings per pair, " << std::thread::hardware_concurrency () << " cores"
+      << std::endl;
+  for (unsigned pairs = 1; pairs <= maxPairs; pairs *= 2)
+    {
+      runPairs<mutexQueue> (bench, "mutex", pairs, n, produceOne<mutexQueue>,
+			    consumeOne<mutexQueue>);
+      runPairs<ring> (bench, "ringQueue", pairs, n, produceOne<ringQueue<myString> >,
+		      consumeOne<ringQueue<myString> >);
+      runPairs<ring> (bench, "ringQueue batch", pairs, n, produceBatch, consumeBatch);
+    }
+
+  const size_t rounds = 100000;
+  ringQueue<size_t> ping (2), pong (2);
+  const benchResult* roundTrip = bench.run ("round trip", [&]()
+    {
+      std::thread echo ([&]()
+	{
+	  size_t value;
+	  for (size_t i = 0; i < rounds; ++i)
+	    {
+	      while (!ping.tryPop (value))
+		std::this_thread::yield ();
+	      pong.push (value + 1);
+	    }
+	});
+      size_t value = 0;
+      for (size_t i = 0; i < rounds; ++i)
+	{
+	  ping.push (value);
+	  while (!pong.tryPop (value))
+	    std::this_thread::yield ();
+	}
+      echo.join ();
+    });
+  if (roundTrip)
+    std::cout << "    " << roundTrip->percentile (50) / rounds << " ns per round trip" << std::endl;
+  return 0;
+}
@@ -0,0 +1,71 @@
+/****************************************************************************************************/
+/*                                                                                                  */
+/* @module        : Cpp 11 features examples                                                        */
+/* @file          : scopeTraceBench.cpp                                                             */
+/* @brief         : Cost of a TRACE_SCOPE                                                           */
+/* @input         :                                                                                 */
+/* @outpu         :                                                                                 */
+/* @date          : 16-October-2026                                                                 */
+/* @author        : Pratik Patil                                                                    */
+/* License        :                                                                                 */
+/*               Copyright (C) 2017  Pratik Patil                                                   */
+/*                                                                                                  */
+/*               This program is free software: you can redistribute it and/or modify               */
+/*               it under the terms of the GNU General Public License Version 3 as published by     */
+/*               the Free Software Foundation.                                                      */
+/*                                                                                                  */
+/*               This program is distributed in the hope that it will be useful,                    */
+/*               but WITHOUT ANY WARRANTY; without even the implied warranty of                     */
+/*               MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                      */
+/*               GNU General Public License for more details.                                       */
+/*                                                                                                  */
+/*               You should have received a copy of the GNU General Public License                  */
+/*               along with this program.  If not, see <http://www.gnu.org/licenses/>.              */
+/****************************************************************************************************/
+// This benchmark measures the tracing itself, so it is always built with it
+#ifndef SCOPE_TRACE
+#define SCOPE_TRACE
+#endif
+#include <chrono>
+#include "benchHarness.h"
+#include "../src/scopeTrace.h"
+
+/*
+ * Description :
+ * Nanoseconds a traced scope adds: an empty scope, a TRACE_SCOPE, two nested ones, against a
+ * steady_clock::now () call for scale. Run with SCOPE_TRACE_COUNTERS=1 to measure scopes which
+ * also read the hardware counters (when perf events are available).
+ *
+ * usage : scopeTraceBench [--json file] [--reps n] [--warmup ms] [--filter text]
+ */
+
+int
+main (int argc, char* argv[])
+{
+  benchHarness bench (argc, argv);
+  std::cout << "hardware counters " << (scopeTrace::countersAvailable () ? "on" : "off")
+      << std::endl;
+  int value = 0;
+  bench.run ("empty scope", [&]()
+    {
+      doNotOptimize (++value);
+    });
+  bench.run ("TRACE_SCOPE", [&]()
+    {
+      TRACE_SCOPE ("bench");
+      doNotOptimize (++value);
+    });
+  bench.run ("TRACE_SCOPE, nested twice", [&]()
+    {
+      TRACE_SCOPE ("outer");
+	{
+	  TRACE_SCOPE ("inner");
+	  doNotOptimize (++value);
+	}
+    });
+  bench.run ("steady_clock::now", [&]()
+    {
+      doNotOptimize (std::chrono::steady_clock::now ());
+    });
+  return 0;
+}
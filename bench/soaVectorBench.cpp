@@ -0,0 +1,153 @@
+/****************************************************************************************************/
+/*                                                                                                  */
+/* @module        : Cpp 11 features examples                                                        */
+/* @file          : soaVectorBench.cpp                                                              */
+/* @brief         : Single field scans over soaVector against std::vector of records                */
+/* @input         :                                                                                 */
+/* @outpu         :                                                                                 */
+/* @date          : 16-October-2026                                                                 */
+/* @author        : Pratik Patil                                                                    */
+/* License        :                                                                                 */
+/*               Copyright (C) 2017  Pratik Patil                                                   */
+/*                                                                                                  */
+/*               This program is free software: you can redistribute it and/or modify               */
+/*               it under the terms of the GNU General Public License Version 3 as published by     */
+/*               the Free Software Foundation.                                                      */
+/*                                                                                                  */
+/*               This program is distributed in the hope that it will be useful,                    */
+/*               but WITHOUT ANY WARRANTY; without even the implied warranty of                     */
+/*               MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                      */
+/*               GNU General Public License for more details.                                       */
+/*                                                                                                  */
+/*               You should have received a copy of the GNU General Public License                  */
+/*               along with this program.  If not, see <http://www.gnu.org/licenses/>.              */
+/****************************************************************************************************/
+#include <iostream>
+#include <string>
+#include <vector>
+#include "benchHarness.h"
+#include "../src/soaVector.h"
+
+/*
+ * Description :
+ * n records of { int intVal; float floatVal; } with the virtual destructor of
+ * defaultConstructorStruct (deleted_Default.cpp), so the vector pays for a vptr per record,
+ * against the same data in a soaVector. Every scan touches only one field. After each pair the
+ * speedup of the median is printed.
+ *
+ * usage : soaVectorBench [n, default 10^7] [benchHarness options]
+ * build : make benches
+ */
+
+struct defaultConstructorStruct
+{
+  defaultConstructorStruct () = default;
+  virtual
+  ~defaultConstructorStruct () = default;
+  int intVal;
+  float floatVal;
+};
+
+struct defaultConstructorRef
+{
+  int& intVal;
+  float& floatVal;
+};
+
+///
+/// Times the vector and the soaVector version of one scan
+///
+template<class AOS, class SOA>
+  void
+  compare (benchHarness& bench, const std::string& name, AOS aos, SOA soa)
+  {
+    const benchResult* a = bench.run (name + " vector", aos);
+    const benchResult* s = bench.run (name + " soaVector", soa);
+    if (a && s)
+      std::cout << "    x" << a->percentile (50) / s->percentile (50) << std::endl;
+  }
+
+int
+main (int argc, char* argv[])
+{
+  benchHarness bench (argc, argv, 10);
+  size_t n = bench.argument (0, 10000000);
+  std::vector<defaultConstructorStruct> aos (n);
+  soaVector<defaultConstructorRef, int, float> soa;
+  soa.reserve (n);
+  for (size_t i = 0; i < n; ++i)
+    {
+      aos[i].intVal = int (i * 7 % 1000);
+      aos[i].floatVal = float (i % 100);
+      soa.push_back (aos[i].intVal, aos[i].floatVal);
+    }
+  std::cout << "record size : " << sizeof(defaultConstructorStruct) << " bytes vs "
+      << sizeof(int) + sizeof(float) << " bytes in columns" << std::endl;
+
+  compare (bench, "sum intVal", [&]()
+    {
+      long long sum = 0;
+      for (const defaultConstructorStruct& r : aos)
+	sum += r.intVal;
+      doNotOptimize (sum);
+    }, [&]()
+    {
+      long long sum = 0;
+      const int* c = soa.column<0> ();
+      for (size_t i = 0; i < n; ++i)
+	sum += c[i];
+      doNotOptimize (sum);
+    });
+
+  compare (bench, "count floatVal", [&]()
+    {
+      size_t count = 0;
+      for (const defaultConstructorStruct& r : aos)
+	count += r.floatVal > 50.0f;
+      doNotOptimize (count);
+    }, [&]()
+    {
+      doNotOptimize (soa.countIf<1> ([](float f)
+	{ return f > 50.0f;}));
+    });
+
+  compare (bench, "map floatVal", [&]()
+    {
+      for (defaultConstructorStruct& r : aos)
+	r.floatVal = r.floatVal * 0.5f + 1.0f;
+      clobberMemory ();
+    }, [&]()
+    {
+      soa.mapColumn<1> ([](float f)
+	{ return f * 0.5f + 1.0f;});
+      clobberMemory ();
+    });
+
+  compare (bench, "filter intVal", [&]()
+    {
+      std::vector<size_t> out;
+      for (size_t i = 0; i < n; ++i)
+	if (aos[i].intVal < 100)
+	  out.push_back (i);
+      doNotOptimize (out.size ());
+    }, [&]()
+    {
+      doNotOptimize (soa.filter<0> ([](int v)
+	{ return v < 100;}).size ());
+    });
+
+  compare (bench, "proxy iteration", [&]()
+    {
+      long long sum = 0;
+      for (const defaultConstructorStruct& r : aos)
+	sum += r.intVal;
+      doNotOptimize (sum);
+    }, [&]()
+    {
+      long long sum = 0;
+      for (defaultConstructorRef rec : soa)
+	sum += rec.intVal;
+      doNotOptimize (sum);
+    });
+  return 0;
+}
@@ -0,0 +1,114 @@
+/****************************************************************************************************/
+/*                                                                                                  */
+/* @module        : Cpp 11 features examples                                                        */
+/* @file          : sortBench.cpp                                                                   */
+/* @brief         : radixSort and parallelMergeSort against std::sort                               */
+/* @input         :                                                                                 */
+/* @outpu         :                                                                                 */
+/* @date          : 16-October-2026                                                                 */
+/* @author        : Pratik Patil                                                                    */
+/* License        :                                                                                 */
+/*               Copyright (C) 2017  Pratik Patil                                                   */
+/*                                                                                                  */
+/*               This program is free software: you can redistribute it and/or modify               */
+/*               it under the terms of the GNU General Public License Version 3 as published by     */
+/*               the Free Software Foundation.                                                      */
+/*                                                                                                  */
+/*               This program is distributed in the hope that it will be useful,                    */
+/*               but WITHOUT ANY WARRANTY; without even the implied warranty of                     */
+/*               MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                      */
+/*               GNU General Public License for more details.                                       */
+/*                                                                                                  */
+/*               You should have received a copy of the GNU General Public License                  */
+/*               along with this program.  If not, see <http://www.gnu.org/licenses/>.              */
+/****************************************************************************************************/
+#include <iostream>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include "benchHarness.h"
+#include "../src/parallelSort.h"
+
+/*
+ * Description :
+ * Sorts 10^6 up to 10^max random values (32 bit keys, 64 bit keys, and 64 bit key / 32 bit value
+ * pairs sorted by key) with std::sort, radixSort and parallelMergeSort, and checks the results
+ * are the same. The input is generated again before every run and not timed. Runs keep the input
+ * plus a buffer of the same size: 10^9 32 bit keys need 8 GB. The harness defaults to 3 reps
+ * without warmup here, one run of a big sort is long enough.
+ *
+ * usage : sortBench [max, default 8] [benchHarness options]
+ * build : make benches
+ */
+
+typedef std::pair<uint64_t, uint32_t> keyValue;
+
+template<class T>
+  void
+  fill (std::vector<T>& values, uint64_t seed)
+  {
+    std::mt19937_64 rng (seed);
+    for (T& v : values)
+      v = T (rng ());
+  }
+
+void
+fill (std::vector<keyValue>& values, uint64_t seed)
+{
+  std::mt19937_64 rng (seed);
+  for (size_t i = 0; i < values.size (); ++i)
+    values[i] = keyValue (rng (), uint32_t (i));
+}
+
+template<class T, class KEY, class LESS>
+  void
+  compare (benchHarness& bench, const std::string& name, size_t n, KEY key, LESS less)
+  {
+    std::vector<T> values (n);
+    fill (values, 42);
+    std::sort (values.begin (), values.end (), less);
+    std::vector<uint64_t> expected (n);
+    for (size_t i = 0; i < n; ++i)
+      expected[i] = key (values[i]);
+    auto same = [&]()
+      {
+	for (size_t i = 0; i < n; ++i)
+	  if (uint64_t (key (values[i])) != expected[i])
+	    return false;
+	return true;
+      };
+    auto refill = [&]()
+      { fill (values, 42);};
+
+    bench.run (name + " std::sort", refill, [&]()
+      { std::sort (values.begin (), values.end (), less);});
+    if (bench.run (name + " radixSort", refill, [&]()
+      { radixSort (values.begin (), values.end (), key);}) && !same ())
+      std::cout << "radixSort result differs" << std::endl;
+    if (bench.run (name + " parallelMergeSort", refill, [&]()
+      { parallelMergeSort (values.begin (), values.end (), less);}) && !same ())
+      std::cout << "parallelMergeSort result differs" << std::endl;
+  }
+
+int
+main (int argc, char* argv[])
+{
+  benchHarness bench (argc, argv, 3, 0);
+  int maxExponent = bench.argument (0, 8);
+  std::cout << threadPool::global ().size () << " threads" << std::endl;
+  size_t n = 1000000;
+  for (int e = 6; e <= maxExponent; ++e, n *= 10)
+    {
+      std::string size = "10^" + std::to_string (e) + " ";
+      compare<uint32_t> (bench, size + "uint32", n, identityKey (), std::less<uint32_t> ());
+      compare<uint64_t> (bench, size + "uint64", n, identityKey (), std::less<uint64_t> ());
+      compare<keyValue> (bench, size + "key/value", n, [](const keyValue& kv)
+	{ return kv.first;}, [](const keyValue& a, const keyValue& b)
+	{ return a.first < b.first;});
+    }
+  return 0;
+}
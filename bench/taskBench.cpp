@@ -0,0 +1,109 @@
+/****************************************************************************************************/
+/*                                                                                                  */
+/* @module        : Cpp 11 features examples                                                        */
+/* @file          : taskBench.cpp                                                                   */
+/* @brief         : Fan out of small jobs: inline, std::async and tasks                             */
+/* @input         :                                                                                 */
+/* @outpu         :                                                                                 */
+/* @date          : 16-October-2026                                                                 */
+/* @author        : Pratik Patil                                                                    */
+/* License        :                                                                                 */
+/*               Copyright (C) 2017  Pratik Patil                                                   */
+/*                                                                                                  */
+/*               This program is free software: you can redistribute it and/or modify               */
+/*               it under the terms of the GNU General Public License Version 3 as published by     */
+/*               the Free Software Foundation.                                                      */
+/*                                                                                                  */
+/*               This program is distributed in the hope that it will be useful,                    */
+/*               but WITHOUT ANY WARRANTY; without even the implied warranty of                     */
+/*               MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                      */
+/*               GNU General Public License for more details.                                       */
+/*                                                                                                  */
+/*               You should have received a copy of the GNU General Public License                  */
+/*               along with this program.  If not, see <http://www.gnu.org/licenses/>.              */
+/****************************************************************************************************/
+#include <future>
+#include <string>
+#include <vector>
+#include "benchHarness.h"
+#include "../src/asciiCase.h"
+#include "../src/task.h"
+
+/*
+ * Description :
+ * Counts the uppercase letters of 64 strings of 4 KB, the way a request fans out to independent
+ * jobs and waits for all of them:
+ * - one after the other on the calling thread,
+ * - one std::async thread per string,
+ * - one spawn () task per string on the global threadPool, joined with whenAll ().
+ * Then the cost of the task machinery itself: spawn + get of an empty job, then () on a task that
+ * is done already (runs inline) and readyTask.
+ *
+ * usage : taskBench [--json file] [--reps n] [--warmup ms] [--filter text]
+ */
+
+static const size_t s_jobs = 64;
+static const size_t s_length = 4096;
+
+int
+main (int argc, char* argv[])
+{
+  benchHarness bench (argc, argv);
+  std::vector<std::string> lines;
+  for (size_t i = 0; i < s_jobs; ++i)
+    {
+      std::string line;
+      while (line.size () < s_length)
+	line += "Request " + std::to_string (i) + " From Client ";
+      lines.push_back (line);
+    }
+  auto count = [](const std::string& s)
+    { return asciiCountUpper (s.data (), s.size ());};
+
+  bench.run ("fan out: sequential", [&]()
+    {
+      size_t total = 0;
+      for (const std::string& line : lines)
+	total += count (line);
+      doNotOptimize (total);
+    });
+  bench.run ("fan out: std::async", [&]()
+    {
+      std::vector<std::future<size_t> > counts;
+      for (const std::string& line : lines)
+	counts.push_back (std::async (std::launch::async, count, std::cref (line)));
+      size_t total = 0;
+      for (std::future<size_t>& c : counts)
+	total += c.get ();
+      doNotOptimize (total);
+    });
+  bench.run ("fan out: spawn + whenAll", [&]()
+    {
+      std::vector<task<size_t> > counts;
+      for (const std::string& line : lines)
+	counts.push_back (spawn ([&line, count]()
+	  { return count (line);}));
+      task<std::vector<size_t> > all = whenAll (counts);
+      size_t total = 0;
+      for (size_t c : all.get ())
+	total += c;
+      doNotOptimize (total);
+    });
+
+  bench.run ("task: spawn + get", [&]()
+    {
+      doNotOptimize (spawn ([]()
+	{ return 1;}).get ());
+    });
+  task<int> done = readyTask (1);
+  bench.run ("task: then on a done task", [&]()
+    {
+      doNotOptimize (done.then ([](const task<int>& t)
+	{ return t.get () + 1;}).get ());
+    });
+  bench.run ("task: readyTask", [&]()
+    {
+      doNotOptimize (readyTask (1).get ());
+    });
+  return 0;
+}
@@ -0,0 +1,132 @@
+/****************************************************************************************************/
+/*                                                                                                  */
+/* @module        : Cpp 11 features examples                                                        */
+/* @file          : textStreamBench.cpp                                                             */
+/* @brief         : Whole file in a string against textPipeline over read and mmap                  */
+/* @input         :                                                                                 */
+/* @outpu         :                                                                                 */
+/* @date          : 16-October-2026                                                                 */
+/* @author        : Pratik Patil                                                                    */
+/* License        :                                                                                 */
+/*               Copyright (C) 2017  Pratik Patil                                                   */
+/*                                                                                                  */
+/*               This program is free software: you can redistribute it and/or modify               */
+/*               it under the terms of the GNU General Public License Version 3 as published by     */
+/*               the Free Software Foundation.                                                      */
+/*                                                                                                  */
+/*               This program is distributed in the hope that it will be useful,                    */
+/*               but WITHOUT ANY WARRANTY; without even the implied warranty of                     */
+/*               MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                      */
+/*               GNU General Public License for more details.                                       */
+/*                                                                                                  */
+/*               You should have received a copy of the GNU General Public License                  */
+/*               along with this program.  If not, see <http://www.gnu.org/licenses/>.              */
+/****************************************************************************************************/
+#include <iostream>
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include "benchHarness.h"
+#include "../src/asciiCase.h"
+#include "../src/textStream.h"
+
+/*
+ * Description :
+ * Writes a log like file of n MB, then counts uppercase letters, finds the first '#' and
+ * uppercases everything:
+ * - the way LambdaExpression.cpp works: read the file into a string, then run the lambdas,
+ * - through a textPipeline fed by read (2),
+ * - through a textPipeline over a mappedFile, split over the global threadPool.
+ * The file is read once before timing, which gives the expected results and puts it in the page
+ * cache for all runs.
+ * After each run the median is printed as GB/s.
+ *
+ * usage : textStreamBench [n MB, default 256] [benchHarness options]
+ * build : make benches
+ */
+
+void
+throughput (const benchResult* r, size_t bytes)
+{
+  if (r)
+    std::cout << "    " << bytes / r->percentile (50) << " GB/s" << std::endl;
+}
+
+int
+main (int argc, char* argv[])
+{
+  benchHarness bench (argc, argv, 5);
+  size_t mb = bench.argument (0, 256);
+  char path[] = "/tmp/textStreamBenchXXXXXX";
+  int fd = mkstemp (path);
+  if (fd < 0)
+    {
+      std::cout << "can't create a temporary file" << std::endl;
+      return 1;
+    }
+  close (fd);
+  {
+    std::ofstream out (path);
+    std::string line;
+    for (size_t i = 0, written = 0; written < (mb << 20); ++i)
+      {
+	line = "2026-10-16 12:00:00 INFO request " + std::to_string (i)
+	    + " served in 12 ms by Worker-" + std::to_string (i % 16) + "\n";
+	out << line;
+	written += line.size ();
+      }
+    out << "# end\n";
+  }
+
+  auto isUpper = [](char c)
+    { return c >= 'A' && c <= 'Z';};
+  auto inString = [&](size_t& upper, size_t& found)
+    {
+      std::ifstream in (path);
+      std::stringstream ss;
+      ss << in.rdbuf ();
+      std::string s = ss.str ();
+      upper = std::count_if (s.begin (), s.end (), isUpper);
+      found = s.find ('#');
+      asciiToUpper (&s[0], s.size ());
+      doNotOptimize (s);
+    };
+  size_t upper, found;
+  inString (upper, found);
+
+  std::cout << mb << " MB, " << threadPool::global ().size () << " threads" << std::endl;
+  throughput (bench.run ("string", [&]()
+    {
+      size_t u, f;
+      inString (u, f);
+      doNotOptimize (u);
+      doNotOptimize (f);
+    }), mb << 20);
+  auto makePipeline = [isUpper]()
+    {
+      return makeTextPipeline (textCount (isUpper), textFind ([](char c)
+	{ return c == '#';}), textBlocks ([](char* s, size_t n)
+	{ asciiToUpper (s, n);}));
+    };
+  throughput (bench.run ("streamFile", [&]()
+    {
+      auto pipeline = makePipeline ();
+      streamFile (path, pipeline);
+      if (std::get<0> (pipeline.stages ()).count () != upper
+	  || std::get<1> (pipeline.stages ()).offset () != found)
+	std::cout << "streamFile result differs" << std::endl;
+    }), mb << 20);
+  throughput (bench.run ("streamMapped", [&]()
+    {
+      auto pipeline = makePipeline ();
+      mappedFile file (path);
+      streamMapped (file, pipeline);
+      if (std::get<0> (pipeline.stages ()).count () != upper
+	  || std::get<1> (pipeline.stages ()).offset () != found)
+	std::cout << "streamMapped result differs" << std::endl;
+    }), mb << 20);
+  unlink (path);
+  return 0;
+}
@@ -27,6 +27,13 @@
 #include <cstring>
 #include <algorithm>
 #include <vector>
+#include "asciiCase.h"
+#include "outputBuffer.h"
+#include "parallelSort.h"
+#include "search.h"
+#include "task.h"
+#include "textStream.h"
+#include "threadPool.h"
 using namespace std;
 /*
  * Description :
@@ -59,68 +66,185 @@ using namespace std;
 
 ///
 /// simple lambda expression using single char to convert it into upper case
-/// note that this lambda returns nothing as well as captures nothing
+/// note that this lambda returns nothing as well as captures nothing.
+/// The conversion itself is done by asciiToUpper (asciiCase.h), which handles 16/32 chars at a
+/// time with SIMD, the lambda only hands the converted string to cout in one write.
 ///
 void
 toUppserCase (string& s)
 {
-  cout << " Converted to all uppercase: ";
-  for_each (s.c_str (), s.c_str () + s.size (), [] (char c)
+  string upper (s.size (), '\0');
+  asciiToUpper (s.data (), &upper[0], s.size ());
+  auto print = [] (const string& str)
     {
-      cout << (char)toupper(c);
-    });
-  cout << endl;
+      cout << " Converted to all uppercase: " << str << endl;
+    };
+  print (upper);
 }
 
 ///
 /// Lambda expression that captures single int value
+/// The lambda is called once for the whole string and counts with asciiCountUpper (SIMD) instead
+/// of being called by for_each for every char and testing it with isupper().
 ///
 void
 countUpperCase (string& s)
 {
   int Uppercase = 0; //modified by the lambda
-  for_each (s.c_str (), s.c_str () + s.size (),
-	    [/*capture*/&Uppercase] (/*parameters*/char c)
-	      {
-		/*body*/
-		if (isupper(c))
-		Uppercase++;
-	      });
+  auto count = [/*capture*/&Uppercase] (/*parameters*/const string& str)
+    {
+      /*body*/
+      Uppercase += asciiCountUpper (str.data (), str.size ());
+    };
+  count (s);
   cout << Uppercase << " uppercase letters in: " << s << endl;
 }
 
 ///
 /// Lambda expression that captures multiple values
+/// min and max start from the first element, starting them from 0 gave wrong results when all
+/// values are positive (min) or all negative (max). For big arrays use minMax (minMax.h), which
+/// does the same reduction with SIMD lanes and several threads. The elements are formatted into an
+/// outputBuffer, which reaches cout in one write.
 ///
 void
 findMinMax (int* arr, int size)
 {
-  int min (0);
-  int max (0);
-  cout << "Array : { ";
-  for_each (arr, arr + size, [&min, &max] (int a)
+  if (size <= 0)
+    return;
+  int min (arr[0]);
+  int max (arr[0]);
+  outputBuffer out (cout);
+  out << "Array : { ";
+  for_each (arr, arr + size, [&min, &max, &out] (int a)
     {
-      cout << a << ", ";
+      out << a << ", ";
       if(min > a)
       min = a;
 
       if(max < a)
       max = a;
     });
-  cout << " }" << endl << "Min : " << min << "\nMax : " << max << endl;
+  out << " }\nMin : " << min << "\nMax : " << max << '\n';
 }
 
 ///
 /// Lambda expression that returns value
+/// The vector is taken by reference, not copied for every call, and a search without a match is
+/// reported instead of dereferencing end(). search.h has the same search over a plain range with
+/// a SIMD compare for greaterThan(num), a multi threaded version and searches for sorted data.
 ///
 void
-findFirst (vector<int> arr, int num)
+findFirst (const vector<int>& arr, int num)
 {
-  vector<int>::iterator p = find_if (arr.begin (), arr.end (), [num](int i)->int
+  vector<int>::const_iterator p = find_if (arr.begin (), arr.end (), [num](int i)->bool
     {
       return i > num;
     });
-  cout << "First number greater than " << num << " is : " << *p << endl;
+  if (p == arr.end ())
+    cout << "No number greater than " << num << endl;
+  else
+    cout << "First number greater than " << num << " is : " << *p << endl;
+}
+
+///
+/// findFirst on sorted data: sorted once, a query is a binary search instead of a scan.
+/// radixSort orders integers by their bytes without comparing them, parallelMergeSort takes the
+/// same comparator lambdas as std::sort (here: descending).
+///
+void
+findFirstSorted (vector<int> arr, int num)
+{
+  radixSort (arr.begin (), arr.end ());
+  const int* p = sortedUpperBound (arr.data (), arr.data () + arr.size (), num);
+  if (p == arr.data () + arr.size ())
+    cout << "No number greater than " << num << endl;
+  else
+    cout << "Smallest number greater than " << num << " is : " << *p << endl;
+
+  parallelMergeSort (arr.begin (), arr.end (), [](int a, int b)
+    {
+      return a > b;
+    });
+  cout << "Largest : " << arr.front () << endl;
+}
+
+///
+/// countUpperCase's lambda over many strings at once: each string is counted in its own task on
+/// the threadPool, whenAll joins the counts and the continuation adds them up once the last one is
+/// in, without a thread per string. A cancelled request doesn't start its jobs at all.
+///
+void
+countUpperCaseConcurrently (const vector<string>& lines)
+{
+  auto count = [](const string& str)
+    {
+      return asciiCountUpper (str.data (), str.size ());
+    };
+  vector<task<size_t> > counts;
+  for (const string& line : lines)
+    counts.push_back (spawn ([&line, count]()
+      {
+	return count (line);
+      }));
+  task<size_t> total = whenAll (counts).then ([](const task<vector<size_t> >& all)
+    {
+      size_t sum = 0;
+      for (size_t c : all.get ())
+      sum += c;
+      return sum;
+    });
+  cout << total.get () << " uppercase letters in " << lines.size () << " strings" << endl;
+
+  cancelSource request;
+  request.cancel ();
+  task<size_t> skipped = spawn ([&lines, count]()
+    {
+      return count (lines.front ());
+    }, request.token ());
+  try
+    {
+      skipped.get ();
+    }
+  catch (const taskCancelled& e)
+    {
+      cout << "Cancelled request : " << e.what () << endl;
+    }
+}
+
+///
+/// The same lambdas over a whole file, without reading it into a string: the file is mapped and
+/// streamed through the stages block by block (textStream.h), in parallel if it is big.
+///
+void
+fileStatistics (const char* path)
+{
+  auto pipeline = makeTextPipeline (textBlocks ([](char* s, size_t n)
+    {
+      asciiToUpper (s, n);
+    }), textCount ([](char c)
+    {
+      return c >= 'A' && c <= 'Z';
+    }), textFind ([](char c)
+    {
+      return c == '{';
+    }), textCount ([](char c)
+    {
+      return c == '\n';
+    }));
+  try
+    {
+      mappedFile file (path);
+      streamMapped (file, pipeline);
+    }
+  catch (const system_error& e)
+    {
+      cout << e.what () << endl;
+      return;
+    }
+  cout << path << " : " << get<3> (pipeline.stages ()).count () << " lines, "
+      << get<1> (pipeline.stages ()).count () << " letters, first '{' at offset "
+      << get<2> (pipeline.stages ()).offset () << endl;
 }
 
 int
@@ -130,12 +254,30 @@ main (int argc, char* argv[])
   string s = "Hello World!";
   countUpperCase (s);
   toUppserCase (s);
+  countUpperCaseConcurrently (vector<string> (8, s));
 
   int arr[] =
     { 1, 2, 4, 5, 7, 8 };
   findMinMax (arr, sizeof(arr) / sizeof(*arr));
   vector<int> vec (arr, arr + sizeof(arr) / sizeof(*arr));
   findFirst (vec, 3);
+  findFirst (vec, 8);
+  findFirstSorted (vector<int> (vec.rbegin (), vec.rend ()), 3);
+
+  ///
+  /// The same lambdas can be handed to the parallel algorithms of threadPool.h, which run them on
+  /// all cores. Only the algorithm name changes.
+  ///
+  vector<int> squares (vec.size ());
+  parallelTransform (vec.begin (), vec.end (), squares.begin (), [](int a)
+    {
+      return a * a;
+    });
+  int sum = parallelReduce (squares.begin (), squares.end (), 0, [](int a, int b)
+    {
+      return a + b;
+    });
+  cout << "Sum of squares : " << sum << endl;
 
   ///
   /// Another way of executing lambda
@@ -144,5 +286,7 @@ main (int argc, char* argv[])
   auto lambda = [](void) -> void
     { cout << "Code within a lambda expression" << endl;};
   lambda ();
+
+  fileStatistics (argc > 1 ? argv[1] : __FILE__);
   return retVal;
 }
@@ -0,0 +1,483 @@
+/****************************************************************************************************/
+/*                                                                                                  */
+/* @module        : Cpp 11 features examples                                                        */
+/* @file          : allocTracker.cpp                                                                */
+/* @brief         : Replaces global operator new/delete when built with -DALLOC_TRACKER             */
+/* @input         :                                                                                 */
+/* @outpu         :                                                                                 */
+/* @date          : 16-October-2026                                                                 */
+/* @author        : Pratik Patil                                                                    */
+/* License        :                                                                                 */
+/*               Copyright (C) 2017  Pratik Patil                                                   */
+/*                                                                                                  */
+/*               This program is free software: you can redistribute it and/or modify               */
+/*               it under the terms of the GNU General Public License Version 3 as published by     */
+/*               the Free Software Foundation.                                                      */
+/*                                                                                                  */
+/*               This program is distributed in the hope that it will be useful,                    */
+/*               but WITHOUT ANY WARRANTY; without even the implied warranty of                     */
+/*               MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                      */
+/*               GNU General Public License for more details.                                       */
+/*                                                                                                  */
+/*               You should have received a copy of the GNU General Public License                  */
+/*               along with this program.  If not, see <http://www.gnu.org/licenses/>.              */
+/****************************************************************************************************/
+#include "allocTracker.h"
+
+#ifndef ALLOC_TRACKER
+
+allocTotals
+allocTracker::totals ()
+{
+  allocTotals t =
+    { 0, 0, 0, 0, 0 };
+  return t;
+}
+
+void
+allocTracker::report (FILE* out)
+{
+  fprintf (out, "allocTracker : disabled, build with -DALLOC_TRACKER\n");
+}
+
+#else
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <execinfo.h>
+
+/*
+ * The functions between operator new and the backtrace call live in their own section, so
+ * captureSite can tell their frames from the caller's by address. How many of them show up in a
+ * backtrace depends on what the compiler inlined. The linker defines the start and stop symbols
+ * for sections named like identifiers.
+ */
+#define ALLOC_TRACKER_TEXT __attribute__((section ("allocTrackerText")))
+extern "C" char __start_allocTrackerText[];
+extern "C" char __stop_allocTrackerText[];
+
+static bool
+trackerFrame (void* pc)
+{
+  char* p = static_cast<char*> (pc);
+  return p >= __start_allocTrackerText && p < __stop_allocTrackerText;
+}
+
+/*
+ * Every block is laid out as [header][user bytes]. weight is 0 for blocks which were not sampled,
+ * otherwise the number of allocations the sample stands for, and site its call site.
+ */
+struct allocHeader
+{
+  size_t size;
+  uint32_t site;
+  uint32_t weight;
+};
+static_assert (sizeof(allocHeader) % alignof(std::max_align_t) == 0,
+    "allocHeader must keep the user block aligned");
+
+static const int s_frames = 4;              // frames kept per call site
+static const int s_spareFrames = 6;         // captured on top, room for the tracker's own frames
+static const uint32_t s_sites = 4096;       // slot 0 collects sites which found no free slot
+static const int64_t s_flushBytes = 16 << 10;
+static const int s_defaultSample = 1024;
+
+struct allocSite
+{
+  std::atomic<uint64_t> key;
+  std::atomic<bool> ready;
+  void* frames[s_frames];
+  int frameCount;
+  std::atomic<int64_t> count;
+  std::atomic<int64_t> bytes;
+  std::atomic<int64_t> liveCount;
+  std::atomic<int64_t> liveBytes;
+};
+
+///
+/// Counters of one thread. Buffers are never freed, a thread which exits marks its buffer unused
+/// and the next new thread takes it over, so summing all buffers always gives the totals.
+///
+struct allocBuffer
+{
+  std::atomic<int64_t> allocations;
+  std::atomic<int64_t> bytes;
+  std::atomic<int64_t> liveBlocks;
+  std::atomic<int64_t> pending;
+  std::atomic<bool> inUse;
+  allocBuffer* next;
+  int64_t highest; // highest pending since the last flush, owner thread only
+  int countdown;   // allocations until the next sample, < 0 before the first one
+  int sinceSample; // allocations since the last sample, the weight of the next one
+};
+
+static allocSite g_sites[s_sites];
+static std::atomic<allocBuffer*> g_buffers;
+static allocBuffer g_shared; // threads whose buffer is already gone, updated with atomic adds
+static std::atomic<int64_t> g_live;
+static std::atomic<int64_t> g_peak;
+static std::atomic<int> g_sampleEvery (-1);
+static std::atomic<uint32_t> g_sampleSeed;
+
+static thread_local allocBuffer* t_buffer;
+static thread_local bool t_inside;
+static thread_local bool t_gone;
+
+template<class T>
+  static void
+  bump (std::atomic<T>& value, T n)
+  {
+    value.store (value.load (std::memory_order_relaxed) + n, std::memory_order_relaxed);
+  }
+
+///
+/// Adds bytes to the shared live count, highest is how far above the old count it went meanwhile
+///
+static void
+addLive (int64_t bytes, int64_t highest)
+{
+  int64_t live = g_live.fetch_add (bytes, std::memory_order_relaxed) + std::max (bytes, highest);
+  int64_t peak = g_peak.load (std::memory_order_relaxed);
+  while (live > peak && !g_peak.compare_exchange_weak (peak, live, std::memory_order_relaxed))
+    ;
+}
+
+static void
+flush (allocBuffer* b)
+{
+  int64_t pending = b->pending.load (std::memory_order_relaxed);
+  b->pending.store (0, std::memory_order_relaxed);
+  addLive (pending, b->highest);
+  b->highest = 0;
+}
+
+struct allocBufferOwner
+{
+  ~allocBufferOwner ()
+  {
+    flush (t_buffer);
+    t_buffer->inUse.store (false, std::memory_order_release);
+    t_buffer = nullptr;
+    t_gone = true;
+  }
+};
+
+static allocBuffer*
+localBuffer ()
+{
+  if (t_buffer)
+    return t_buffer;
+  if (t_gone || t_inside)
+    return nullptr;
+  t_inside = true;
+  allocBuffer* b = g_buffers.load (std::memory_order_acquire);
+  for (; b; b = b->next)
+    {
+      bool unused = false;
+      if (!b->inUse.load (std::memory_order_relaxed)
+	  && b->inUse.compare_exchange_strong (unused, true, std::memory_order_acquire))
+	break;
+    }
+  if (!b)
+    {
+      // malloc, not new: this runs inside operator new
+      b = static_cast<allocBuffer*> (calloc (1, sizeof(allocBuffer)));
+      if (!b)
+	{
+	  t_inside = false;
+	  return nullptr;
+	}
+      b->inUse.store (true, std::memory_order_relaxed);
+      b->next = g_buffers.load (std::memory_order_relaxed);
+      while (!g_buffers.compare_exchange_weak (b->next, b, std::memory_order_release))
+	;
+    }
+  b->countdown = -1;
+  b->sinceSample = 0;
+  t_buffer = b;
+  static thread_local allocBufferOwner owner;
+  (void) owner;
+  t_inside = false;
+  return b;
+}
+
+static int
+sampleEvery ()
+{
+  int every = g_sampleEvery.load (std::memory_order_relaxed);
+  if (every < 0)
+    {
+      const char* env = getenv ("ALLOC_TRACKER_SAMPLE");
+      every = env ? std::max (atoi (env), 0) : s_defaultSample;
+      g_sampleEvery.store (every, std::memory_order_relaxed);
+    }
+  return every;
+}
+
+///
+/// Countdown to the first sample of a thread, spread over [1, every] so that threads do not all
+/// sample their first allocation (thread start up) and short lived threads still get sampled
+///
+static int
+firstCountdown (int every)
+{
+  uint32_t x = g_sampleSeed.fetch_add (0x9e3779b9, std::memory_order_relaxed);
+  x ^= x >> 16;
+  x *= 0x85ebca6b;
+  x ^= x >> 13;
+  return 1 + int (x % uint32_t (every));
+}
+
+static uint32_t __attribute__((noinline)) ALLOC_TRACKER_TEXT
+captureSite ()
+{
+  void* frames[s_frames + s_spareFrames];
+  t_inside = true;
+  int captured = backtrace (frames, s_frames + s_spareFrames);
+  t_inside = false;
+  int skip = 0;
+  while (skip < captured && trackerFrame (frames[skip]))
+    ++skip;
+  int n = std::min (captured - skip, s_frames);
+  if (n <= 0)
+    return 0;
+  uint64_t key = 14695981039346656037ULL;
+  for (int i = 0; i < n; ++i)
+    key = (key ^ reinterpret_cast<uintptr_t> (frames[skip + i])) * 1099511628211ULL;
+  key |= 1;
+  for (uint32_t probe = 0; probe < 64; ++probe)
+    {
+      uint32_t index = 1 + (key + probe) % (s_sites - 1);
+      allocSite& s = g_sites[index];
+      uint64_t k = s.key.load (std::memory_order_relaxed);
+      if (!k && s.key.compare_exchange_strong (k, key, std::memory_order_relaxed))
+	{
+	  std::copy (frames + skip, frames + skip + n, s.frames);
+	  s.frameCount = n;
+	  s.ready.store (true, std::memory_order_release);
+	  return index;
+	}
+      if (k == key)
+	return index;
+    }
+  return 0;
+}
+
+static void* __attribute__((noinline)) ALLOC_TRACKER_TEXT
+allocate (size_t size)
+{
+  allocHeader* h = static_cast<allocHeader*> (malloc (sizeof(allocHeader) + size));
+  if (!h)
+    return nullptr;
+  h->size = size;
+  h->site = 0;
+  h->weight = 0;
+  allocBuffer* b = localBuffer ();
+  if (!b)
+    {
+      g_shared.allocations.fetch_add (1, std::memory_order_relaxed);
+      g_shared.bytes.fetch_add (size, std::memory_order_relaxed);
+      g_shared.liveBlocks.fetch_add (1, std::memory_order_relaxed);
+      addLive (size, 0);
+      return h + 1;
+    }
+  bump<int64_t> (b->allocations, 1);
+  bump<int64_t> (b->bytes, size);
+  bump<int64_t> (b->liveBlocks, 1);
+  bump<int64_t> (b->pending, size);
+  int64_t pending = b->pending.load (std::memory_order_relaxed);
+  b->highest = std::max (b->highest, pending);
+  if (pending >= s_flushBytes)
+    flush (b);
+  int every = sampleEvery ();
+  if (!every)
+    return h + 1;
+  if (b->countdown < 0)
+    b->countdown = firstCountdown (every);
+  ++b->sinceSample;
+  if (--b->countdown == 0)
+    {
+      // the sample stands for the allocations since the previous one, not a fixed every
+      int weight = b->sinceSample;
+      b->countdown = every;
+      b->sinceSample = 0;
+      allocSite& s = g_sites[h->site = captureSite ()];
+      h->weight = weight;
+      s.count.fetch_add (weight, std::memory_order_relaxed);
+      s.bytes.fetch_add (int64_t (size) * weight, std::memory_order_relaxed);
+      s.liveCount.fetch_add (weight, std::memory_order_relaxed);
+      s.liveBytes.fetch_add (int64_t (size) * weight, std::memory_order_relaxed);
+    }
+  return h + 1;
+}
+
+static void
+release (void* p)
+{
+  if (!p)
+    return;
+  allocHeader* h = static_cast<allocHeader*> (p) - 1;
+  int64_t size = h->size;
+  if (h->weight)
+    {
+      allocSite& s = g_sites[h->site];
+      s.liveCount.fetch_sub (h->weight, std::memory_order_relaxed);
+      s.liveBytes.fetch_sub (size * h->weight, std::memory_order_relaxed);
+    }
+  allocBuffer* b = localBuffer ();
+  if (!b)
+    {
+      g_shared.liveBlocks.fetch_sub (1, std::memory_order_relaxed);
+      addLive (-size, 0);
+    }
+  else
+    {
+      bump<int64_t> (b->liveBlocks, -1);
+      bump<int64_t> (b->pending, -size);
+      if (b->pending.load (std::memory_order_relaxed) <= -s_flushBytes)
+	flush (b);
+    }
+  free (h);
+}
+
+static void* ALLOC_TRACKER_TEXT
+allocateOrThrow (size_t size)
+{
+  for (;;)
+    {
+      if (void* p = allocate (size))
+	return p;
+      std::new_handler handler = std::get_new_handler ();
+      if (!handler)
+	throw std::bad_alloc ();
+      handler ();
+    }
+}
+
+void* ALLOC_TRACKER_TEXT
+operator new (size_t size)
+{
+  return allocateOrThrow (size);
+}
+void* ALLOC_TRACKER_TEXT
+operator new[] (size_t size)
+{
+  return allocateOrThrow (size);
+}
+void* ALLOC_TRACKER_TEXT
+operator new (size_t size, const std::nothrow_t&) noexcept
+{
+  try
+    {
+      return allocateOrThrow (size);
+    }
+  catch (...)
+    {
+      return nullptr;
+    }
+}
+void* ALLOC_TRACKER_TEXT
+operator new[] (size_t size, const std::nothrow_t&) noexcept
+{
+  return operator new (size, std::nothrow);
+}
+void
+operator delete (void* p) noexcept
+{
+  release (p);
+}
+void
+operator delete[] (void* p) noexcept
+{
+  release (p);
+}
+void
+operator delete (void* p, const std::nothrow_t&) noexcept
+{
+  release (p);
+}
+void
+operator delete[] (void* p, const std::nothrow_t&) noexcept
+{
+  release (p);
+}
+
+allocTotals
+allocTracker::totals ()
+{
+  allocTotals t =
+    { 0, 0, 0, g_live.load (std::memory_order_relaxed), 0 };
+  for (allocBuffer* b = g_buffers.load (std::memory_order_acquire); b; b = b->next)
+    {
+      t.allocations += b->allocations.load (std::memory_order_relaxed);
+      t.bytes += b->bytes.load (std::memory_order_relaxed);
+      t.liveBlocks += b->liveBlocks.load (std::memory_order_relaxed);
+      t.liveBytes += b->pending.load (std::memory_order_relaxed);
+    }
+  t.allocations += g_shared.allocations.load (std::memory_order_relaxed);
+  t.bytes += g_shared.bytes.load (std::memory_order_relaxed);
+  t.liveBlocks += g_shared.liveBlocks.load (std::memory_order_relaxed);
+  t.peakBytes = std::max (g_peak.load (std::memory_order_relaxed), t.liveBytes);
+  return t;
+}
+
+void
+allocTracker::report (FILE* out)
+{
+  static const uint32_t s_shown = 16;
+  static uint32_t order[s_sites]; // static: no allocation while reporting
+  allocTotals t = totals ();
+  fprintf (out, "allocTracker : %lld allocations, %lld bytes, peak %lld bytes live, "
+	   "%lld bytes in %lld blocks still live\n",
+	   (long long) t.allocations, (long long) t.bytes, (long long) t.peakBytes,
+	   (long long) t.liveBytes, (long long) t.liveBlocks);
+  int every = sampleEvery ();
+  if (!every)
+    return;
+  uint32_t n = 0;
+  for (uint32_t i = 0; i < s_sites; ++i)
+    if (g_sites[i].count.load (std::memory_order_relaxed))
+      order[n++] = i;
+  std::sort (order, order + n, [](uint32_t a, uint32_t b)
+    {
+      return g_sites[a].bytes.load (std::memory_order_relaxed)
+	  > g_sites[b].bytes.load (std::memory_order_relaxed);
+    });
+  fprintf (out, "call sites by bytes, sampled 1 in %d%s:\n", every, every > 1 ? " (estimates)" : "");
+  for (uint32_t i = 0; i < n && i < s_shown; ++i)
+    {
+      allocSite& s = g_sites[order[i]];
+      fprintf (out, "  %lld allocations, %lld bytes, %lld bytes in %lld blocks live\n",
+	       (long long) s.count.load (std::memory_order_relaxed),
+	       (long long) s.bytes.load (std::memory_order_relaxed),
+	       (long long) s.liveBytes.load (std::memory_order_relaxed),
+	       (long long) s.liveCount.load (std::memory_order_relaxed));
+      if (s.ready.load (std::memory_order_acquire))
+	{
+	  fflush (out);
+	  backtrace_symbols_fd (s.frames, s.frameCount, fileno (out));
+	}
+      else
+	fprintf (out, "    (sites which found no free slot)\n");
+    }
+}
+
+///
+/// Runs after the static destructors, so their frees are accounted for
+///
+static void __attribute__((destructor))
+reportAtExit ()
+{
+  const char* path = getenv ("ALLOC_TRACKER_REPORT");
+  FILE* out = path ? fopen (path, "w") : stderr;
+  if (!out)
+    return;
+  allocTracker::report (out);
+  if (out != stderr)
+    fclose (out);
+}
+
+#endif /* ALLOC_TRACKER */
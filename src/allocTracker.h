@@ -0,0 +1,89 @@
+/****************************************************************************************************/
+/*                                                                                                  */
+/* @module        : Cpp 11 features examples                                                        */
+/* @file          : allocTracker.h                                                                  */
+/* @brief         : Opt in global operator new/delete tracking: counts, peak, leaks, call sites     */
+/* @input         :                                                                                 */
+/* @outpu         :                                                                                 */
+/* @date          : 16-October-2026                                                                 */
+/* @author        : Pratik Patil                                                                    */
+/* License        :                                                                                 */
+/*               Copyright (C) 2017  Pratik Patil                                                   */
+/*                                                                                                  */
+/*               This program is free software: you can redistribute it and/or modify               */
+/*               it under the terms of the GNU General Public License Version 3 as published by     */
+/*               the Free Software Foundation.                                                      */
+/*                                                                                                  */
+/*               This program is distributed in the hope that it will be useful,                    */
+/*               but WITHOUT ANY WARRANTY; without even the implied warranty of                     */
+/*               MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                      */
+/*               GNU General Public License for more details.                                       */
+/*                                                                                                  */
+/*               You should have received a copy of the GNU General Public License                  */
+/*               along with this program.  If not, see <http://www.gnu.org/licenses/>.              */
+/****************************************************************************************************/
+#ifndef ALLOCTRACKER_H_
+#define ALLOCTRACKER_H_
+
+#include <cstdint>
+#include <cstdio>
+#include <ostream>
+
+/*
+ * Description:
+ *   allocTracker.cpp replaces the global operator new and delete when it is compiled with
+ *   -DALLOC_TRACKER. It is not excluded from any build configuration, so adding the define to the
+ *   compiler flags of a configuration is all it takes; without the define the file is empty apart
+ *   from the functions below, which then report zeros.
+ *
+ *   - Totals are exact: every block carries a 16 byte header with its size, and each thread keeps
+ *     its counts in its own buffer with plain (relaxed) loads and stores. Live bytes are handed to
+ *     a shared counter every s_flushBytes, which is where the peak is taken. With several threads
+ *     the peak may be off by up to s_flushBytes per thread, with one it is exact.
+ *   - Call sites are sampled: every ALLOC_TRACKER_SAMPLE-th allocation of a thread (default 1024, 1
+ *     records all, 0 none) captures a short backtrace and counts for the allocations made since
+ *     the previous sample. The first sample of a thread comes after a random 1 to that many
+ *     allocations. Per site numbers are therefore estimates, unless the sample rate is 1, and
+ *     allocations after the last sample of a thread are in the totals only.
+ *   - At exit the report goes to stderr, or to the file named by ALLOC_TRACKER_REPORT. Remaining
+ *     live blocks are leaks or objects static destructors did not free.
+ *     Frames are printed as binary(+offset); link with -rdynamic to get function names, or pass
+ *     the offsets to addr2line -Cfe <binary>.
+ */
+
+struct allocTotals
+{
+  int64_t allocations;
+  int64_t bytes;
+  int64_t liveBlocks;
+  int64_t liveBytes;
+  int64_t peakBytes;
+};
+
+inline std::ostream&
+operator << (std::ostream& os, const allocTotals& t)
+{
+  return os << "allocations " << t.allocations << ", bytes " << t.bytes << ", live blocks "
+      << t.liveBlocks << ", live bytes " << t.liveBytes << ", peak bytes " << t.peakBytes;
+}
+
+class allocTracker
+{
+public:
+#ifdef ALLOC_TRACKER
+  static const bool enabled = true;
+#else
+  static const bool enabled = false;
+#endif
+
+  static allocTotals
+  totals ();
+
+  ///
+  /// Totals and the call sites with most bytes. Uses only stdio, safe to call during exit
+  ///
+  static void
+  report (FILE* out);
+};
+
+#endif /* ALLOCTRACKER_H_ */
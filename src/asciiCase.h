@@ -0,0 +1,219 @@
+/****************************************************************************************************/
+/*                                                                                                  */
+/* @module        : Cpp 11 features examples                                                        */
+/* @file          : asciiCase.h                                                                     */
+/* @brief         : SIMD ASCII case conversion and uppercase counting with runtime dispatch         */
+/* @input         :                                                                                 */
+/* @outpu         :                                                                                 */
+/* @date          : 16-October-2026                                                                 */
+/* @author        : Pratik Patil                                                                    */
+/* License        :                                                                                 */
+/*               Copyright (C) 2017  Pratik Patil                                                   */
+/*                                                                                                  */
+/*               This program is free software: you can redistribute it and/or modify               */
+/*               it under the terms of the GNU General Public License Version 3 as published by     */
+/*               the Free Software Foundation.                                                      */
+/*                                                                                                  */
+/*               This program is distributed in the hope that it will be useful,                    */
+/*               but WITHOUT ANY WARRANTY; without even the implied warranty of                     */
+/*               MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                      */
+/*               GNU General Public License for more details.                                       */
+/*                                                                                                  */
+/*               You should have received a copy of the GNU General Public License                  */
+/*               along with this program.  If not, see <http://www.gnu.org/licenses/>.              */
+/****************************************************************************************************/
+#ifndef ASCIICASE_H_
+#define ASCIICASE_H_
+
+#include <cstddef>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define ASCIICASE_X86 1
+#endif
+
+/*
+ * Description:
+ *   Converting case with for_each and toupper()/isupper() goes through the locale one char at a time.
+ *   For ASCII text the same work is a range check and flipping bit 0x20, which SIMD does for 16
+ *   (SSE2) or 32 (AVX2) bytes per instruction.
+ *
+ *   asciiToUpper / asciiToLower - in place, or from src to dst (which may be the same buffer)
+ *   asciiCountUpper             - number of 'A'..'Z' bytes
+ *
+ *   Only 'a'..'z' and 'A'..'Z' are touched, every other byte (including UTF-8 sequences) is left as
+ *   it is, which is what toupper()/isupper() do in the "C" locale.
+ *
+ *   The best implementation is picked once at first use: AVX2 when the CPU has it, else SSE2, else
+ *   plain C++ on non x86 targets.
+ */
+
+struct asciiCaseKernels
+{
+  void
+  (*flipToUpper) (const char* src, char* dst, size_t n);
+  void
+  (*flipToLower) (const char* src, char* dst, size_t n);
+  size_t
+  (*countUpper) (const char* src, size_t n);
+
+  static const asciiCaseKernels&
+  get ()
+  {
+    static const asciiCaseKernels kernels = select ();
+    return kernels;
+  }
+
+  ///
+  /// Portable versions, also used for the tails shorter than a vector
+  ///
+  template<char FIRST>
+    static void
+    flipScalar (const char* src, char* dst, size_t n)
+    {
+      for (size_t i = 0; i < n; ++i)
+	{
+	  unsigned char c = src[i];
+	  // (c - FIRST) < 26 as unsigned is true only for the 26 letters starting at FIRST
+	  dst[i] = c ^ ((unsigned char) (c - FIRST) < 26 ? 0x20 : 0);
+	}
+    }
+  static size_t
+  countScalar (const char* src, size_t n)
+  {
+    size_t count = 0;
+    for (size_t i = 0; i < n; ++i)
+      count += (unsigned char) (src[i] - 'A') < 26;
+    return count;
+  }
+
+#ifdef ASCIICASE_X86
+  /*
+   * There is no unsigned byte compare in SSE2/AVX2. Adding 128 - FIRST moves FIRST..FIRST+25 to
+   * -128..-103 as signed bytes, every other value lands above, so one signed compare finds them.
+   */
+  template<char FIRST>
+    static void
+    flipSse2 (const char* src, char* dst, size_t n)
+    {
+      const __m128i shift = _mm_set1_epi8 ((char) (128 - FIRST));
+      const __m128i limit = _mm_set1_epi8 (-128 + 26);
+      const __m128i bit = _mm_set1_epi8 (0x20);
+      size_t i = 0;
+      for (; i + 16 <= n; i += 16)
+	{
+	  __m128i x = _mm_loadu_si128 ((const __m128i *) (src + i));
+	  __m128i inRange = _mm_cmplt_epi8 (_mm_add_epi8 (x, shift), limit);
+	  _mm_storeu_si128 ((__m128i *) (dst + i), _mm_xor_si128 (x, _mm_and_si128 (inRange, bit)));
+	}
+      flipScalar<FIRST> (src + i, dst + i, n - i);
+    }
+  static size_t
+  countSse2 (const char* src, size_t n)
+  {
+    const __m128i shift = _mm_set1_epi8 ((char) (128 - 'A'));
+    const __m128i limit = _mm_set1_epi8 (-128 + 26);
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+      {
+	__m128i x = _mm_loadu_si128 ((const __m128i *) (src + i));
+	__m128i inRange = _mm_cmplt_epi8 (_mm_add_epi8 (x, shift), limit);
+	count += __builtin_popcount (_mm_movemask_epi8 (inRange));
+      }
+    return count + countScalar (src + i, n - i);
+  }
+
+  template<char FIRST>
+    __attribute__((target("avx2"))) static void
+    flipAvx2 (const char* src, char* dst, size_t n)
+    {
+      const __m256i shift = _mm256_set1_epi8 ((char) (128 - FIRST));
+      const __m256i limit = _mm256_set1_epi8 (-128 + 26);
+      const __m256i bit = _mm256_set1_epi8 (0x20);
+      size_t i = 0;
+      for (; i + 32 <= n; i += 32)
+	{
+	  __m256i x = _mm256_loadu_si256 ((const __m256i *) (src + i));
+	  // limit > x + shift, i.e. x + shift < limit
+	  __m256i inRange = _mm256_cmpgt_epi8 (limit, _mm256_add_epi8 (x, shift));
+	  _mm256_storeu_si256 ((__m256i *) (dst + i),
+			       _mm256_xor_si256 (x, _mm256_and_si256 (inRange, bit)));
+	}
+      flipSse2<FIRST> (src + i, dst + i, n - i);
+    }
+  __attribute__((target("avx2,popcnt"))) static size_t
+  countAvx2 (const char* src, size_t n)
+  {
+    const __m256i shift = _mm256_set1_epi8 ((char) (128 - 'A'));
+    const __m256i limit = _mm256_set1_epi8 (-128 + 26);
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32)
+      {
+	__m256i x = _mm256_loadu_si256 ((const __m256i *) (src + i));
+	__m256i inRange = _mm256_cmpgt_epi8 (limit, _mm256_add_epi8 (x, shift));
+	count += __builtin_popcount ((unsigned) _mm256_movemask_epi8 (inRange));
+      }
+    return count + countSse2 (src + i, n - i);
+  }
+#endif
+
+private:
+  static asciiCaseKernels
+  select ()
+  {
+    asciiCaseKernels k;
+#ifdef ASCIICASE_X86
+    __builtin_cpu_init ();
+    if (__builtin_cpu_supports ("avx2"))
+      {
+	k.flipToUpper = &flipAvx2<'a'>;
+	k.flipToLower = &flipAvx2<'A'>;
+	k.countUpper = &countAvx2;
+	return k;
+      }
+#ifdef __SSE2__
+    k.flipToUpper = &flipSse2<'a'>;
+    k.flipToLower = &flipSse2<'A'>;
+    k.countUpper = &countSse2;
+    return k;
+#endif
+#endif
+    k.flipToUpper = &flipScalar<'a'>;
+    k.flipToLower = &flipScalar<'A'>;
+    k.countUpper = &countScalar;
+    return k;
+  }
+};
+
+inline void
+asciiToUpper (const char* src, char* dst, size_t n)
+{
+  asciiCaseKernels::get ().flipToUpper (src, dst, n);
+}
+
+inline void
+asciiToUpper (char* s, size_t n)
+{
+  asciiCaseKernels::get ().flipToUpper (s, s, n);
+}
+
+inline void
+asciiToLower (const char* src, char* dst, size_t n)
+{
+  asciiCaseKernels::get ().flipToLower (src, dst, n);
+}
+
+inline void
+asciiToLower (char* s, size_t n)
+{
+  asciiCaseKernels::get ().flipToLower (s, s, n);
+}
+
+inline size_t
+asciiCountUpper (const char* s, size_t n)
+{
+  return asciiCaseKernels::get ().countUpper (s, n);
+}
+
+#endif /* ASCIICASE_H_ */
@@ -26,6 +26,9 @@
 #include <initializer_list>
 #include <vector>
 #include <algorithm>
+#include "functionRef.h"
+#include "outputBuffer.h"
+#include "scopeTrace.h"
 /*
  * Description :
  * In C++11, compiler can detect type of objects automatically. The new auto and decltype facilities
@@ -75,8 +78,9 @@ simpleAuto (void)
   if (dirty)
     std::cout << "It's dirty" << std::endl;
 
-  auto p = new char[1024]; // with pointers
+  auto p = new char[1024] (); // with pointers, () zero fills the buffer so it prints as ""
   std::cout << p << std::endl;
+  delete[] p;
 
   auto distance = 10000000000LL; // with huge numbers
   std::cout << distance << std::endl;
@@ -84,6 +88,15 @@ simpleAuto (void)
   auto pf = func;
   pf ();
 
+  // functionRef holds either a function or a lambda, without allocating, see functionRef.h
+  functionRef<void
+  ()> rf = func2;
+  rf ();
+  auto lambda = [&x]()
+    { std::cout << "lambda sees x = " << x << std::endl;};
+  rf = lambda;
+  rf ();
+
 }
 ///
 /// If you want to declare cv-qualified objects, you have to provide the const and volatile qualifiers
@@ -149,6 +162,7 @@ simpleDecltype (void)
 void
 realUseDecltyp (void)
 {
+  TRACE_SCOPE ("realUseDecltyp");
   std::vector<int> vf;
 
   vf.push_back (0);
@@ -156,10 +170,12 @@ realUseDecltyp (void)
   vf.push_back (2);
   typedef decltype(vf.begin()) ITER;
 
-  std::cout << "Printing vf : " << std::endl;
+  // one line per element into a buffer, handed to std::cout once instead of flushing every line
+  outputBuffer out (std::cout);
+  out << "Printing vf : \n";
   for (ITER it = vf.begin (); it < vf.end (); it++)
 
-    std::cout << *it << std::endl;
+    out << *it << '\n';
 }
 
 ///
@@ -202,10 +218,11 @@ main (int argc, char* argv[])
   vi.push_back (0);
   vi.push_back (1);
 
-  std::cout << "Using template with decltype to loop in vector" << std::endl;
-  std::for_each (vi.begin (), get_end (vi), [](int a)
+  outputBuffer out (std::cout);
+  out << "Using template with decltype to loop in vector\n";
+  std::for_each (vi.begin (), get_end (vi), [&out](int a)
     {
-      std::cout << a << std::endl;
+      out << a << '\n';
     });
   return 0;
 }
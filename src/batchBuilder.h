@@ -0,0 +1,167 @@
+/****************************************************************************************************/
+/*                                                                                                  */
+/* @module        : Cpp 11 features examples                                                        */
+/* @file          : batchBuilder.h                                                                  */
+/* @brief         : Constructs many objects in place in a few preallocated blocks                   */
+/* @input         :                                                                                 */
+/* @outpu         :                                                                                 */
+/* @date          : 16-October-2026                                                                 */
+/* @author        : Pratik Patil                                                                    */
+/* License        :                                                                                 */
+/*               Copyright (C) 2017  Pratik Patil                                                   */
+/*                                                                                                  */
+/*               This program is free software: you can redistribute it and/or modify               */
+/*               it under the terms of the GNU General Public License Version 3 as published by     */
+/*               the Free Software Foundation.                                                      */
+/*                                                                                                  */
+/*               This program is distributed in the hope that it will be useful,                    */
+/*               but WITHOUT ANY WARRANTY; without even the implied warranty of                     */
+/*               MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                      */
+/*               GNU General Public License for more details.                                       */
+/*                                                                                                  */
+/*               You should have received a copy of the GNU General Public License                  */
+/*               along with this program.  If not, see <http://www.gnu.org/licenses/>.              */
+/****************************************************************************************************/
+#ifndef BATCHBUILDER_H_
+#define BATCHBUILDER_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+/*
+ * Description:
+ *   Building thousands of objects with new costs one heap allocation each and scatters them over
+ *   the heap. batchBuilder<T> takes raw storage for blockSize objects at once and constructs the
+ *   objects in place, one after the other:
+ *
+ *     batchBuilder<delegatingConstructor> nodes (10000);
+ *     nodes.reserve (10000);                      // one allocation up front
+ *     nodes.generate (10000, [](size_t i) { return delegatingConstructor (int (i)); });
+ *     delegatingConstructor& first = nodes[0];
+ *
+ *   Objects never move once built (a full block is followed by a new one, not reallocated), so
+ *   references to them stay valid until the builder goes away. The builder destroys the objects
+ *   in reverse order of construction.
+ */
+
+template<class T>
+  class batchBuilder
+  {
+  public:
+    explicit
+    batchBuilder (size_t blockSize = 1024) :
+	m_blockSize (blockSize ? blockSize : 1), m_size (0), m_capacity (0), m_current (0)
+    {
+    }
+    ~batchBuilder ()
+    {
+      clear ();
+      for (T* block : m_blocks)
+	::operator delete (block);
+    }
+    batchBuilder (const batchBuilder&) = delete;
+    batchBuilder&
+    operator = (const batchBuilder&) = delete;
+
+    ///
+    /// Makes room for count more objects with at most one allocation
+    ///
+    void
+    reserve (size_t count)
+    {
+      if (m_capacity - m_size >= count)
+	return;
+      addBlock (std::max (count - (m_capacity - m_size), m_blockSize));
+    }
+
+    template<class ... ARGS>
+      T&
+      emplace (ARGS&&... args)
+      {
+	T* place = next ();
+	new (place) T (std::forward<ARGS> (args)...);
+	++m_counts[m_current];
+	++m_size;
+	return *place;
+      }
+
+    ///
+    /// Constructs count objects from make (index), index counting from the current size
+    ///
+    template<class MAKE>
+      void
+      generate (size_t count, MAKE make)
+      {
+	reserve (count);
+	for (size_t i = 0; i < count; ++i)
+	  emplace (make (m_size));
+      }
+
+    size_t
+    size () const
+    {
+      return m_size;
+    }
+    ///
+    /// Walks the blocks, so a builder with few big blocks (see reserve) indexes fastest
+    ///
+    T&
+    operator [] (size_t index)
+    {
+      for (size_t b = 0;; ++b)
+	{
+	  if (index < m_counts[b])
+	    return m_blocks[b][index];
+	  index -= m_counts[b];
+	}
+    }
+
+    ///
+    /// Destroys all objects, the blocks are kept for the next batch
+    ///
+    void
+    clear ()
+    {
+      for (size_t b = m_blocks.size (); b-- > 0;)
+	{
+	  for (size_t i = m_counts[b]; i-- > 0;)
+	    m_blocks[b][i].~T ();
+	  m_counts[b] = 0;
+	}
+      m_size = 0;
+      m_current = 0;
+    }
+
+  private:
+    size_t m_blockSize;
+    size_t m_size;
+    size_t m_capacity;
+    size_t m_current;             // block being filled
+    std::vector<T*> m_blocks;
+    std::vector<size_t> m_capacities;
+    std::vector<size_t> m_counts; // objects built in each block
+
+    void
+    addBlock (size_t capacity)
+    {
+      m_blocks.push_back (static_cast<T*> (::operator new (capacity * sizeof(T))));
+      m_capacities.push_back (capacity);
+      m_counts.push_back (0);
+      m_capacity += capacity;
+    }
+
+    T*
+    next ()
+    {
+      if (m_size == m_capacity)
+	addBlock (m_blockSize);
+      while (m_counts[m_current] == m_capacities[m_current])
+	++m_current;
+      return m_blocks[m_current] + m_counts[m_current];
+    }
+  };
+
+#endif /* BATCHBUILDER_H_ */
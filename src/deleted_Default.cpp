@@ -23,6 +23,8 @@
 /*               along with this program.  If not, see <http://www.gnu.org/licenses/>.              */
 /****************************************************************************************************/
 #include <iostream>
+#include "objectPool.h"
+#include "soaVector.h"
 /*
  * Description :
  * default -
@@ -47,6 +49,17 @@ struct defaultConstructorStruct
   float floatVal;
 };
 
+///
+/// The virtual destructor puts a vptr in every defaultConstructorStruct, 16 bytes for 8 bytes of
+/// data. Big arrays of such records are better kept column wise in a soaVector (soaVector.h), and
+/// this struct of references lets code still write rec.intVal and rec.floatVal.
+///
+struct defaultConstructorRef
+{
+  int& intVal;
+  float& floatVal;
+};
+
 struct deletedCopyStructError
 {
   //using delete here, is also deleteding default constructor.
@@ -71,6 +84,29 @@ main (int argc, char* argv[])
   defaultConstructorStruct a; // This will call compiler generated default constructor
   deletedCopyStruct d;
 
+  soaVector<defaultConstructorRef, int, float> records;
+  for (int i = 0; i < 4; ++i)
+    records.push_back (i, i * 1.5f);
+  for (defaultConstructorRef rec : records)
+    rec.intVal *= 10;
+  std::cout << "records with floatVal > 2 : " << records.countIf<1> ([](float f)
+    { return f > 2;}) << ", intVal of last : " << records[3].intVal << std::endl;
+
+  // deletedCopyStruct can't be copied, but a handle owning it can be moved around ...
+  uniqueHandle<deletedCopyStruct*, deletePointer<deletedCopyStruct>> owner (new deletedCopyStruct);
+  std::vector<uniqueHandle<deletedCopyStruct*, deletePointer<deletedCopyStruct>>> owners;
+  owners.push_back (std::move (owner));
+  std::cout << "owner moved : " << !owner << ", owners : " << owners.size () << std::endl;
+
+  // ... and instead of new and delete for every use, a pool hands out the same objects again
+  objectPool<deletedCopyStruct> pool;
+  for (int i = 0; i < 1000; ++i)
+    {
+      objectPool<deletedCopyStruct>::lease first = pool.acquire ();
+      objectPool<deletedCopyStruct>::lease second = pool.acquire ();
+    }
+  std::cout << "1000 x 2 leases, objects created : " << pool.created () << std::endl;
+
   //  deletedCopyStruct error (d);   // This will be an error as copy constructor is deleted.
   //deletedCopyStructError e;     //This line will cause error as there is no default constructor provided
 
@@ -0,0 +1,340 @@
+/****************************************************************************************************/
+/*                                                                                                  */
+/* @module        : Cpp 11 features examples                                                        */
+/* @file          : flatHashMap.h                                                                   */
+/* @brief         : Open addressing hash map with SIMD probed control bytes and dense entries       */
+/* @input         :                                                                                 */
+/* @outpu         :                                                                                 */
+/* @date          : 16-October-2026                                                                 */
+/* @author        : Pratik Patil                                                                    */
+/* License        :                                                                                 */
+/*               Copyright (C) 2017  Pratik Patil                                                   */
+/*                                                                                                  */
+/*               This program is free software: you can redistribute it and/or modify               */
+/*               it under the terms of the GNU General Public License Version 3 as published by     */
+/*               the Free Software Foundation.                                                      */
+/*                                                                                                  */
+/*               This program is distributed in the hope that it will be useful,                    */
+/*               but WITHOUT ANY WARRANTY; without even the implied warranty of                     */
+/*               MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                      */
+/*               GNU General Public License for more details.                                       */
+/*                                                                                                  */
+/*               You should have received a copy of the GNU General Public License                  */
+/*               along with this program.  If not, see <http://www.gnu.org/licenses/>.              */
+/****************************************************************************************************/
+#ifndef FLATHASHMAP_H_
+#define FLATHASHMAP_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+#if defined(__GNUC__) && defined(__SSE2__)
+#include <emmintrin.h>
+#define FLATHASHMAP_SSE2 1
+#endif
+
+/*
+ * Description:
+ *   flatHashMap<K, V> is a drop in for the std::map / std::unordered_map uses in the samples:
+ *
+ *     flatHashMap<std::string, std::string> singers =
+ *       { { "Lady Gaga", "+1 (212) 555-7890" }, { "Beyonce Knowles", "+1 (212) 555-0987" } };
+ *     for (const auto& s : singers) ...
+ *
+ *   Dense entries -
+ *   The key/value pairs live back to back in one vector, in insertion order, without holes. There
+ *   are no per node allocations and iteration is a linear walk over memory. erase() moves the last
+ *   entry into the hole, so it changes the order and invalidates pointers to the last entry.
+ *
+ *   Index -
+ *   Lookup goes through an open addressing table of slots holding entry numbers. Next to it is one
+ *   control byte per slot: empty, deleted, or 7 bits of the key's hash. Slots are probed 16 at a
+ *   time: one SSE2 compare of the 16 control bytes against the 7 hash bits gives a bit mask of the
+ *   few slots worth comparing keys for, and an empty slot in the group ends the search. Groups are
+ *   visited in triangular order, which reaches every group since their number is a power of two.
+ *   The table is grown at 7/8 load.
+ *
+ *   Keys must not be changed through the iterators, only values.
+ */
+
+template<class K, class V, class HASH = std::hash<K>, class EQ = std::equal_to<K> >
+  class flatHashMap
+  {
+  public:
+    typedef K key_type;
+    typedef V mapped_type;
+    typedef std::pair<K, V> value_type;
+    typedef typename std::vector<value_type>::iterator iterator;
+    typedef typename std::vector<value_type>::const_iterator const_iterator;
+
+    flatHashMap () :
+	m_groupShift (64), m_used (0)
+    {
+    }
+    flatHashMap (std::initializer_list<value_type> init) :
+	flatHashMap ()
+    {
+      reserve (init.size ());
+      for (const value_type& v : init)
+	insert (v);
+    }
+
+    iterator
+    begin ()
+    {
+      return m_entries.begin ();
+    }
+    iterator
+    end ()
+    {
+      return m_entries.end ();
+    }
+    const_iterator
+    begin () const
+    {
+      return m_entries.begin ();
+    }
+    const_iterator
+    end () const
+    {
+      return m_entries.end ();
+    }
+    size_t
+    size () const
+    {
+      return m_entries.size ();
+    }
+    bool
+    empty () const
+    {
+      return m_entries.empty ();
+    }
+
+    void
+    clear ()
+    {
+      m_entries.clear ();
+      m_ctrl.assign (m_ctrl.size (), int8_t (s_empty));
+      m_used = 0;
+    }
+
+    ///
+    /// Makes room for n entries without growing the index again
+    ///
+    void
+    reserve (size_t n)
+    {
+      m_entries.reserve (n);
+      size_t slots = s_group;
+      while (slots * 7 / 8 < n)
+	slots *= 2;
+      if (slots > m_ctrl.size ())
+	rehash (slots);
+    }
+
+    iterator
+    find (const K& key)
+    {
+      size_t slot = findSlot (key, hashOf (key));
+      return slot == s_none ? end () : begin () + m_slots[slot];
+    }
+    const_iterator
+    find (const K& key) const
+    {
+      size_t slot = findSlot (key, hashOf (key));
+      return slot == s_none ? end () : begin () + m_slots[slot];
+    }
+    size_t
+    count (const K& key) const
+    {
+      return findSlot (key, hashOf (key)) != s_none;
+    }
+
+    ///
+    /// Inserts value unless the key is there already. Returns the entry and whether it was added.
+    ///
+    std::pair<iterator, bool>
+    insert (const value_type& value)
+    {
+      return emplace (value.first, value.second);
+    }
+    std::pair<iterator, bool>
+    insert (value_type&& value)
+    {
+      return emplace (std::move (value.first), std::move (value.second));
+    }
+    template<class KEY, class VALUE>
+      std::pair<iterator, bool>
+      emplace (KEY&& key, VALUE&& value)
+      {
+	uint64_t h = hashOf (key);
+	size_t slot = findSlot (key, h);
+	if (slot != s_none)
+	  return std::make_pair (begin () + m_slots[slot], false);
+	m_entries.push_back (value_type (std::forward<KEY> (key), std::forward<VALUE> (value)));
+	addSlot (h, m_entries.size () - 1);
+	return std::make_pair (end () - 1, true);
+      }
+
+    V&
+    operator [] (const K& key)
+    {
+      uint64_t h = hashOf (key);
+      size_t slot = findSlot (key, h);
+      if (slot != s_none)
+	return m_entries[m_slots[slot]].second;
+      m_entries.push_back (value_type (key, V ()));
+      addSlot (h, m_entries.size () - 1);
+      return m_entries.back ().second;
+    }
+
+    size_t
+    erase (const K& key)
+    {
+      size_t slot = findSlot (key, hashOf (key));
+      if (slot == s_none)
+	return 0;
+      uint32_t index = m_slots[slot];
+      m_ctrl[slot] = s_deleted;
+      uint32_t last = m_entries.size () - 1;
+      if (index != last)
+	{
+	  // The last entry moves into the hole, its slot has to follow
+	  size_t lastSlot = findSlot (m_entries[last].first, hashOf (m_entries[last].first));
+	  m_slots[lastSlot] = index;
+	  m_entries[index] = std::move (m_entries[last]);
+	}
+      m_entries.pop_back ();
+      return 1;
+    }
+
+  private:
+    static const size_t s_group = 16;
+    static const size_t s_none = size_t (-1);
+    static const int8_t s_empty = -128;
+    static const int8_t s_deleted = -2;
+
+    std::vector<value_type> m_entries;
+    std::vector<int8_t> m_ctrl;    // one per slot
+    std::vector<uint32_t> m_slots; // entry number of each full slot
+    unsigned m_groupShift;         // hash >> m_groupShift is the first group
+    size_t m_used;                 // full and deleted slots
+    HASH m_hash;
+    EQ m_eq;
+
+    uint64_t
+    hashOf (const K& key) const
+    {
+      // std::hash of integers is the identity, spread the bits before they pick the group
+      uint64_t h = m_hash (key);
+      return (h ^ (h >> 32)) * 0x9E3779B97F4A7C15ull;
+    }
+    static int8_t
+    fingerprint (uint64_t h)
+    {
+      return int8_t ((h >> 25) & 0x7f);
+    }
+    size_t
+    firstGroup (uint64_t h) const
+    {
+      return m_groupShift >= 64 ? 0 : size_t (h >> m_groupShift);
+    }
+    size_t
+    groupMask () const
+    {
+      return m_ctrl.size () / s_group - 1;
+    }
+
+    // Bit i set where control byte i of the group equals c
+    unsigned
+    matchGroup (size_t group, int8_t c) const
+    {
+      const int8_t* ctrl = &m_ctrl[group * s_group];
+#ifdef FLATHASHMAP_SSE2
+      __m128i bytes = _mm_loadu_si128 ((const __m128i *) ctrl);
+      return _mm_movemask_epi8 (_mm_cmpeq_epi8 (bytes, _mm_set1_epi8 (c)));
+#else
+      unsigned mask = 0;
+      for (size_t i = 0; i < s_group; ++i)
+	mask |= unsigned (ctrl[i] == c) << i;
+      return mask;
+#endif
+    }
+
+    size_t
+    findSlot (const K& key, uint64_t h) const
+    {
+      if (m_ctrl.empty ())
+	return s_none;
+      int8_t fp = fingerprint (h);
+      size_t group = firstGroup (h);
+      for (size_t probe = 1; probe <= groupMask () + 1; ++probe)
+	{
+	  for (unsigned match = matchGroup (group, fp); match; match &= match - 1)
+	    {
+	      size_t slot = group * s_group + __builtin_ctz (match);
+	      if (m_eq (m_entries[m_slots[slot]].first, key))
+		return slot;
+	    }
+	  if (matchGroup (group, s_empty))
+	    return s_none;
+	  group = (group + probe) & groupMask ();
+	}
+      return s_none;
+    }
+
+    // Indexes entry index, which is already in m_entries
+    void
+    addSlot (uint64_t h, size_t index)
+    {
+      if (m_ctrl.empty () || (m_used + 1) * 8 > m_ctrl.size () * 7)
+	{
+	  // rehash indexes all entries, the new one included
+	  rehash (m_entries.size () * 8 / 7 * 2 + s_group);
+	  return;
+	}
+      placeSlot (h, index);
+    }
+
+    void
+    placeSlot (uint64_t h, size_t index)
+    {
+      size_t group = firstGroup (h);
+      for (size_t probe = 1;; ++probe)
+	{
+	  unsigned free = matchGroup (group, s_empty) | matchGroup (group, s_deleted);
+	  if (free)
+	    {
+	      size_t slot = group * s_group + __builtin_ctz (free);
+	      if (m_ctrl[slot] == s_empty)
+		++m_used;
+	      m_ctrl[slot] = fingerprint (h);
+	      m_slots[slot] = index;
+	      return;
+	    }
+	  group = (group + probe) & groupMask ();
+	}
+    }
+
+    // Builds the index again with at least slots slots, dropping deleted markers
+    void
+    rehash (size_t slots)
+    {
+      size_t size = s_group;
+      while (size < slots)
+	size *= 2;
+      m_ctrl.assign (size, int8_t (s_empty));
+      m_slots.assign (size, 0);
+      m_groupShift = 64;
+      for (size_t groups = size / s_group; groups > 1; groups /= 2)
+	--m_groupShift;
+      m_used = 0;
+      for (size_t i = 0; i < m_entries.size (); ++i)
+	placeSlot (hashOf (m_entries[i].first), i);
+    }
+  };
+
+#endif /* FLATHASHMAP_H_ */
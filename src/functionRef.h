@@ -0,0 +1,267 @@
+/****************************************************************************************************/
+/*                                                                                                  */
+/* @module        : Cpp 11 features examples                                                        */
+/* @file          : functionRef.h                                                                   */
+/* @brief         : Non allocating callables: functionRef (borrowed) and inplaceFunction (owned)    */
+/* @input         :                                                                                 */
+/* @outpu         :                                                                                 */
+/* @date          : 16-October-2026                                                                 */
+/* @author        : Pratik Patil                                                                    */
+/* License        :                                                                                 */
+/*               Copyright (C) 2017  Pratik Patil                                                   */
+/*                                                                                                  */
+/*               This program is free software: you can redistribute it and/or modify               */
+/*               it under the terms of the GNU General Public License Version 3 as published by     */
+/*               the Free Software Foundation.                                                      */
+/*                                                                                                  */
+/*               This program is distributed in the hope that it will be useful,                    */
+/*               but WITHOUT ANY WARRANTY; without even the implied warranty of                     */
+/*               MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                      */
+/*               GNU General Public License for more details.                                       */
+/*                                                                                                  */
+/*               You should have received a copy of the GNU General Public License                  */
+/*               along with this program.  If not, see <http://www.gnu.org/licenses/>.              */
+/****************************************************************************************************/
+#ifndef FUNCTIONREF_H_
+#define FUNCTIONREF_H_
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/*
+ * Description:
+ *   std::function copies the callable it is given to the heap once the callable is bigger than its
+ *   small buffer (16 bytes in libstdc++, two captured pointers), and every call goes through a
+ *   manager table. Two cheaper types for callbacks:
+ *
+ *   functionRef<R (ARGS...)> refers to a callable it does not own, like a string view does to
+ *   characters: an object pointer and a trampoline, two words, never allocates. Use it for
+ *   parameters, it must not outlive the callable it was made from.
+ *
+ *     void forEachLine (functionRef<void (const char*)> visit);
+ *     forEachLine ([&](const char* line) { ++count; });
+ *
+ *   inplaceFunction<R (ARGS...), SIZE> owns its callable like std::function, but keeps it in a
+ *   buffer of SIZE bytes inside itself. A callable which does not fit is a compile error, not a
+ *   heap allocation. Calling an empty one throws std::bad_function_call.
+ */
+
+template<class SIGNATURE>
+  class functionRef;
+
+template<class R, class ... ARGS>
+  class functionRef<R
+  (ARGS...)>
+  {
+  public:
+    template<class F, class = typename std::enable_if<
+	!std::is_function<typename std::remove_reference<F>::type>::value
+	    && !std::is_same<typename std::decay<F>::type, functionRef>::value>::type>
+      functionRef (F&& f) :
+	  m_call (&callObject<typename std::remove_reference<F>::type>)
+      {
+	m_target.object = const_cast<void*> (static_cast<const void*> (std::addressof (f)));
+      }
+
+    template<class F, class = typename std::enable_if<std::is_function<F>::value>::type>
+      functionRef (F* f) :
+	  m_call (&callFunction<F>)
+      {
+	m_target.function = reinterpret_cast<void
+	(*) ()> (f);
+      }
+
+    R
+    operator () (ARGS ... args) const
+    {
+      return m_call (m_target, std::forward<ARGS> (args)...);
+    }
+
+  private:
+    union target
+    {
+      void* object;
+      void
+      (*function) ();
+    };
+
+    target m_target;
+    R
+    (*m_call) (target, ARGS...);
+
+    template<class F>
+      static R
+      callObject (target t, ARGS ... args)
+      {
+	return (*static_cast<F*> (t.object)) (std::forward<ARGS> (args)...);
+      }
+    template<class F>
+      static R
+      callFunction (target t, ARGS ... args)
+      {
+	return reinterpret_cast<F*> (t.function) (std::forward<ARGS> (args)...);
+      }
+  };
+
+template<class SIGNATURE, size_t SIZE = 4 * sizeof(void*)>
+  class inplaceFunction;
+
+template<class R, class ... ARGS, size_t SIZE>
+  class inplaceFunction<R
+  (ARGS...), SIZE>
+  {
+  public:
+    inplaceFunction () :
+	m_call (&callEmpty), m_ops (nullptr)
+    {
+    }
+    template<class F, class = typename std::enable_if<
+	!std::is_same<typename std::decay<F>::type, inplaceFunction>::value>::type>
+      inplaceFunction (F&& f) :
+	  inplaceFunction ()
+      {
+	typedef typename std::decay<F>::type callable;
+	static_assert (sizeof(callable) <= SIZE, "callable does not fit, raise SIZE of inplaceFunction");
+	static_assert (alignof(callable) <= alignof(std::max_align_t), "callable is over aligned");
+	new (&m_storage) callable (std::forward<F> (f));
+	m_call = &callStored<callable>;
+	m_ops = &opsFor<callable>::table;
+      }
+    ~inplaceFunction ()
+    {
+      reset ();
+    }
+
+    inplaceFunction (const inplaceFunction& f) :
+	inplaceFunction ()
+    {
+      assign (f);
+    }
+    inplaceFunction (inplaceFunction&& f) noexcept :
+	inplaceFunction ()
+    {
+      assign (std::move (f));
+    }
+    inplaceFunction&
+    operator = (const inplaceFunction& f)
+    {
+      if (this != &f)
+	{
+	  reset ();
+	  assign (f);
+	}
+      return *this;
+    }
+    inplaceFunction&
+    operator = (inplaceFunction&& f) noexcept
+    {
+      if (this != &f)
+	{
+	  reset ();
+	  assign (std::move (f));
+	}
+      return *this;
+    }
+
+    R
+    operator () (ARGS ... args) const
+    {
+      return m_call (const_cast<storage*> (&m_storage), std::forward<ARGS> (args)...);
+    }
+    explicit
+    operator bool () const
+    {
+      return m_ops != nullptr;
+    }
+
+    void
+    reset ()
+    {
+      if (m_ops)
+	m_ops->destroy (&m_storage);
+      m_call = &callEmpty;
+      m_ops = nullptr;
+    }
+
+  private:
+    typedef typename std::aligned_storage<SIZE, alignof(std::max_align_t)>::type storage;
+
+    struct ops
+    {
+      void
+      (*copy) (storage* dst, const storage* src);
+      void
+      (*move) (storage* dst, storage* src);
+      void
+      (*destroy) (storage* s);
+    };
+
+    template<class F>
+      struct opsFor
+      {
+	static void
+	copy (storage* dst, const storage* src)
+	{
+	  new (dst) F (*reinterpret_cast<const F*> (src));
+	}
+	static void
+	move (storage* dst, storage* src)
+	{
+	  new (dst) F (std::move (*reinterpret_cast<F*> (src)));
+	}
+	static void
+	destroy (storage* s)
+	{
+	  reinterpret_cast<F*> (s)->~F ();
+	}
+	static const ops table;
+      };
+
+    // the call pointer is kept next to the buffer, calls don't go through the ops table
+    storage m_storage;
+    R
+    (*m_call) (storage*, ARGS...);
+    const ops* m_ops;
+
+    void
+    assign (const inplaceFunction& f)
+    {
+      if (f.m_ops)
+	f.m_ops->copy (&m_storage, &f.m_storage);
+      m_call = f.m_call;
+      m_ops = f.m_ops;
+    }
+    void
+    assign (inplaceFunction&& f)
+    {
+      if (f.m_ops)
+	f.m_ops->move (&m_storage, &f.m_storage);
+      m_call = f.m_call;
+      m_ops = f.m_ops;
+    }
+
+    template<class F>
+      static R
+      callStored (storage* s, ARGS ... args)
+      {
+	return (*reinterpret_cast<F*> (s)) (std::forward<ARGS> (args)...);
+      }
+    static R
+    callEmpty (storage*, ARGS...)
+    {
+      throw std::bad_function_call ();
+    }
+  };
+
+template<class R, class ... ARGS, size_t SIZE>
+  template<class F>
+    const typename inplaceFunction<R
+    (ARGS...), SIZE>::ops inplaceFunction<R
+    (ARGS...), SIZE>::opsFor<F>::table =
+      { &copy, &move, &destroy };
+
+#endif /* FUNCTIONREF_H_ */
@@ -27,6 +27,11 @@
 #include <vector>
 #include <map>
 #include <algorithm>
+#include "flatHashMap.h"
+#include "internPool.h"
+#include "outputBuffer.h"
+#include "scopeTrace.h"
+#include "staticTable.h"
 
 /*
  * Description :
@@ -66,26 +71,87 @@ public:
 
 ///
 /// Initializing stl containers with ease. No need to have lots of push_back.
+/// The lambdas take the elements by const reference, taking std::pair<std::string, std::string> by
+/// value copied both strings of every entry. They write into an outputBuffer, std::endl flushed
+/// std::cout after every line.
 ///
 void
 stlContainersInitialization ()
 {
+  TRACE_SCOPE ("stlContainersInitialization");
+  outputBuffer out (std::cout);
   std::vector<std::string> vs=
     { "first", "second", "third"};
-  std::for_each(vs.begin(),vs.end(),[](std::string s)
+  std::for_each(vs.begin(),vs.end(),[&out](const std::string& s)
 	{
-	  std::cout << s << "\t" <<std::endl;
+	  out << s << "\t\n";
 	});
 
   std::map<std::string,std::string> singers =
     {
 	{ "Lady Gaga", "+1 (212) 555-7890"},
 	{ "Beyonce Knowles", "+1 (212) 555-0987"}};
-  std::for_each(singers.begin(),singers.end(),[]( std::pair<std::string, std::string> s)
+  std::for_each(singers.begin(),singers.end(),[&out](const std::pair<const std::string, std::string>& s)
 	{
-	  std::cout << s.first << "\t" << s.second << std::endl;
+	  out << s.first << "\t" << s.second << '\n';
 	});
+
+  // Same brace initialization works for user defined containers taking an initializer_list.
+  // flatHashMap keeps the entries in one contiguous array and finds them through a SIMD probed
+  // hash index, which suits big name -> phone tables.
+  flatHashMap<std::string,std::string> phonebook =
+    {
+	{ "Lady Gaga", "+1 (212) 555-7890"},
+	{ "Beyonce Knowles", "+1 (212) 555-0987"}};
+  out << "Lady Gaga\t" << phonebook.find ("Lady Gaga")->second << '\n';
+}
+///
+/// When the data is fixed, the same brace lists can be constant expressions. The compiler lays the
+/// tables out in read only memory, nothing is allocated or sorted when the program starts.
+///
+constexpr const char* staticVs[] =
+  { "first", "second", "third" };
+
+constexpr staticEntry<const char*> singerEntries[] =
+  {
+    { "Beyonce Knowles", "+1 (212) 555-0987" },
+    { "Lady Gaga", "+1 (212) 555-7890" } };
+constexpr auto staticSingers = makeStaticTable (singerEntries);
+static_assert (staticSingers.sorted (), "singerEntries must be sorted by name");
+
+void
+staticTableInitialization ()
+{
+  outputBuffer out (std::cout);
+  for (const char* s : staticVs)
+    out << s << "\t\n";
+  for (const staticEntry<const char*>& s : staticSingers)
+    out << s.key << "\t" << s.value << '\n';
+  out << "Lady Gaga\t" << *staticSingers.find ("Lady Gaga") << '\n';
+}
+///
+/// Call logs repeat the same few names over and over. Interned, each name is stored once and a log
+/// entry keeps a 4 byte handle, which is also all the phonebook lookup hashes and compares.
+///
+void
+internedKeysInitialization ()
+{
+  internPool names;
+  flatHashMap<internedString, std::string, internedStringHash> phonebook =
+    {
+	{ names.intern ("Lady Gaga"), "+1 (212) 555-7890"},
+	{ names.intern ("Beyonce Knowles"), "+1 (212) 555-0987"}};
+
+  std::vector<internedString> calls;
+  for (int i = 0; i < 1000; i++)
+    calls.push_back (names.intern (i % 3 ? "Lady Gaga" : "Beyonce Knowles"));
+  internedString gaga = names.intern (myString ("Lady Gaga"));
+  outputBuffer out (std::cout);
+  out << names.view (calls.front ()).data << "\t" << phonebook.find (calls.front ())->second
+      << "\t" << std::count (calls.begin (), calls.end (), gaga) << " calls\n";
+  out << names.stats () << '\n';
 }
+
 int
 main (int argc, char* argv[])
 {
@@ -94,8 +160,12 @@ main (int argc, char* argv[])
 
   int* a = new int[3]
     { 1, 2, 0 };
+  std::cout << "a[1] : " << a[1] << std::endl;
+  delete[] a;
 
   X x;
   stlContainersInitialization ();
+  staticTableInitialization ();
+  internedKeysInitialization ();
   return 0;
 }
@@ -0,0 +1,364 @@
+/****************************************************************************************************/
+/*                                                                                                  */
+/* @module        : Cpp 11 features examples                                                        */
+/* @file          : internPool.h                                                                    */
+/* @brief         : Interns strings into 32 bit handles: integer equality and hashing               */
+/* @input         :                                                                                 */
+/* @outpu         :                                                                                 */
+/* @date          : 16-October-2026                                                                 */
+/* @author        : Pratik Patil                                                                    */
+/* License        :                                                                                 */
+/*               Copyright (C) 2017  Pratik Patil                                                   */
+/*                                                                                                  */
+/*               This program is free software: you can redistribute it and/or modify               */
+/*               it under the terms of the GNU General Public License Version 3 as published by     */
+/*               the Free Software Foundation.                                                      */
+/*                                                                                                  */
+/*               This program is distributed in the hope that it will be useful,                    */
+/*               but WITHOUT ANY WARRANTY; without even the implied warranty of                     */
+/*               MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                      */
+/*               GNU General Public License for more details.                                       */
+/*                                                                                                  */
+/*               You should have received a copy of the GNU General Public License                  */
+/*               along with this program.  If not, see <http://www.gnu.org/licenses/>.              */
+/****************************************************************************************************/
+#ifndef INTERNPOOL_H_
+#define INTERNPOOL_H_
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include "flatHashMap.h"
+#include "myString.h"
+#include "myStringAllocator.h"
+
+/*
+ * Description:
+ *   A myString key is compared with memcmp over its heap buffer, copied with an allocation, and
+ *   a table of a million entries with a thousand distinct names keeps a thousand copies of each.
+ *   internPool stores every distinct string once and hands out an internedString, a 32 bit
+ *   handle. Equal strings get equal handles, so comparing and hashing keys is integer work and
+ *   copying a key is copying 4 bytes:
+ *
+ *     internPool names;
+ *     internedString a = names.intern ("Lady Gaga");
+ *     internedString b = names.intern (std::string ("Lady Gaga"));
+ *     a == b;                            // true
+ *     names.view (a).data;               // "Lady Gaga", 0 terminated
+ *     flatHashMap<internedString, myString, internedStringHash> phonebook;
+ *
+ *   - The pool has s_shards shards, picked by the hash of the string. Each shard has its own lock,
+ *     hash index (flatHashMap) and characters (a myStringArena), so threads interning different
+ *     strings rarely wait on each other.
+ *   - view () takes no lock: a handle names a shard and a slot in that shard's segment table,
+ *     whose segments never move once allocated.
+ *   - Handles of different pools must not be mixed, and strings are only freed with the pool.
+ *   - stats () counts what was interned and estimates the memory saved against keeping one
+ *     myString per intern () call.
+ */
+
+///
+/// Handle of an interned string, 0 is the empty handle
+///
+class internedString
+{
+public:
+  internedString () :
+      m_id (0)
+  {
+  }
+  explicit
+  internedString (uint32_t id) :
+      m_id (id)
+  {
+  }
+  uint32_t
+  id () const
+  {
+    return m_id;
+  }
+  explicit
+  operator bool () const
+  {
+    return m_id != 0;
+  }
+  bool
+  operator == (internedString rhs) const
+  {
+    return m_id == rhs.m_id;
+  }
+  bool
+  operator != (internedString rhs) const
+  {
+    return m_id != rhs.m_id;
+  }
+
+private:
+  uint32_t m_id;
+};
+
+struct internedStringHash
+{
+  size_t
+  operator () (internedString s) const
+  {
+    return s.id () * 0x9E3779B97F4A7C15ULL;
+  }
+};
+
+///
+/// Characters of an interned string, data is 0 terminated
+///
+struct internView
+{
+  const char* data;
+  uint32_t length;
+};
+
+struct internStats
+{
+  uint64_t interned;      // intern () calls
+  uint64_t unique;        // distinct strings stored
+  uint64_t bytesIn;       // characters passed to intern ()
+  uint64_t bytesStored;   // characters, index and segment tables held by the pool
+  uint64_t bytesAsMyString; // the same intern () calls kept as one myString each
+
+  int64_t
+  saved () const
+  {
+    return int64_t (bytesAsMyString) - int64_t (bytesStored + interned * sizeof(internedString));
+  }
+};
+
+///
+/// Works for std::ostream and outputBuffer alike
+///
+template<class OUT>
+  inline OUT&
+  operator << (OUT& os, const internStats& s)
+  {
+    os << s.interned << " strings interned, " << s.unique << " unique, " << s.bytesIn
+	<< " bytes in, " << s.bytesStored << " bytes stored, " << s.bytesAsMyString
+	<< " bytes as myString, saved " << s.saved () << " bytes";
+    return os;
+  }
+
+class internPool
+{
+public:
+  static const uint32_t s_shardBits = 4;
+  static const uint32_t s_shards = 1 << s_shardBits;
+  // segment n of a shard holds 2^(s_firstSegmentBits + n) slots, enough for 2^(32 - s_shardBits)
+  static const uint32_t s_firstSegmentBits = 6;
+  static const uint32_t s_segments = 32 - s_shardBits - s_firstSegmentBits + 1;
+
+  internPool () = default;
+  internPool (const internPool&) = delete;
+  internPool&
+  operator = (const internPool&) = delete;
+
+  internedString
+  intern (const char* s, size_t length)
+  {
+    if (length > UINT32_MAX)
+      throw std::length_error ("internPool: string too long");
+    key k =
+      { s, uint32_t (length), hashOf (s, length) };
+    shard& sh = m_shards[k.hash & (s_shards - 1)];
+    std::lock_guard<std::mutex> lock (sh.mutex);
+    sh.interned++;
+    sh.bytesIn += length;
+    sh.bytesAsMyString += myStringBytes (length);
+    keyIndex::iterator found = sh.index.find (k);
+    if (found != sh.index.end ())
+      return internedString (found->second);
+
+    // slot 0 of shard 0 would give id 0, the empty handle, so slots count from 1
+    uint32_t slot = uint32_t (sh.index.size ()) + 1;
+    if (slot >= 1u << (32 - s_shardBits))
+      throw std::length_error ("internPool: shard full");
+    char* chars = sh.chars.allocate (length + 1);
+    memcpy (chars, s, length);
+    chars[length] = '\0';
+    uint32_t segmentIndex, offset;
+    locate (slot, segmentIndex, offset);
+    std::atomic<internView*>& segment = sh.segments[segmentIndex];
+    internView* views = segment.load (std::memory_order_relaxed);
+    if (!views)
+      {
+	size_t size = size_t (1) << (s_firstSegmentBits + segmentIndex);
+	views = new internView[size];
+	segment.store (views, std::memory_order_release);
+	sh.bytesStored += size * sizeof(internView);
+      }
+    views[offset] =
+      { chars, uint32_t (length) };
+    sh.bytesStored += ((length + 8) & ~size_t (7)) + sizeof(keyIndex::value_type);
+    k.data = chars;
+    uint32_t id = (slot << s_shardBits) | uint32_t (&sh - m_shards);
+    sh.index.emplace (k, id);
+    return internedString (id);
+  }
+  internedString
+  intern (const char* s)
+  {
+    return intern (s, strlen (s));
+  }
+  internedString
+  intern (const std::string& s)
+  {
+    return intern (s.data (), s.size ());
+  }
+  template<class ALLOC>
+    internedString
+    intern (const basicMyString<ALLOC>& s)
+    {
+      return intern (s.m_data ? s.m_data : "", s.length ());
+    }
+
+  ///
+  /// The handle of s if it was interned before, the empty handle otherwise
+  ///
+  internedString
+  find (const char* s, size_t length) const
+  {
+    key k =
+      { s, uint32_t (length), hashOf (s, length) };
+    const shard& sh = m_shards[k.hash & (s_shards - 1)];
+    std::lock_guard<std::mutex> lock (sh.mutex);
+    keyIndex::const_iterator found = sh.index.find (k);
+    return found == sh.index.end () ? internedString () : internedString (found->second);
+  }
+
+  ///
+  /// Characters of a handle, lock free. The empty handle gives "".
+  ///
+  internView
+  view (internedString s) const
+  {
+    if (!s)
+      return internView
+	{ "", 0 };
+    const shard& sh = m_shards[s.id () & (s_shards - 1)];
+    uint32_t segmentIndex, offset;
+    locate (s.id () >> s_shardBits, segmentIndex, offset);
+    return sh.segments[segmentIndex].load (std::memory_order_acquire)[offset];
+  }
+  std::string
+  str (internedString s) const
+  {
+    internView v = view (s);
+    return std::string (v.data, v.length);
+  }
+
+  internStats
+  stats () const
+  {
+    internStats total =
+      { 0, 0, 0, 0, 0 };
+    for (const shard& sh : m_shards)
+      {
+	std::lock_guard<std::mutex> lock (sh.mutex);
+	total.interned += sh.interned;
+	total.unique += sh.index.size ();
+	total.bytesIn += sh.bytesIn;
+	total.bytesStored += sh.bytesStored;
+	total.bytesAsMyString += sh.bytesAsMyString;
+      }
+    return total;
+  }
+
+private:
+  struct key
+  {
+    const char* data;
+    uint32_t length;
+    uint64_t hash;
+  };
+  struct keyHash
+  {
+    size_t
+    operator () (const key& k) const
+    {
+      return k.hash;
+    }
+  };
+  struct keyEqual
+  {
+    bool
+    operator () (const key& a, const key& b) const
+    {
+      return a.hash == b.hash && a.length == b.length && !memcmp (a.data, b.data, a.length);
+    }
+  };
+  typedef flatHashMap<key, uint32_t, keyHash, keyEqual> keyIndex;
+
+  struct shard
+  {
+    mutable std::mutex mutex;
+    keyIndex index;
+    myStringArena chars;
+    std::atomic<internView*> segments[s_segments];
+    uint64_t interned;
+    uint64_t bytesIn;
+    uint64_t bytesStored;
+    uint64_t bytesAsMyString;
+
+    shard () :
+	interned (0), bytesIn (0), bytesStored (0), bytesAsMyString (0)
+    {
+      for (std::atomic<internView*>& s : segments)
+	s.store (nullptr, std::memory_order_relaxed);
+    }
+    ~shard ()
+    {
+      for (std::atomic<internView*>& s : segments)
+	delete[] s.load (std::memory_order_relaxed);
+    }
+  };
+
+  shard m_shards[s_shards];
+
+  static void
+  locate (uint32_t slot, uint32_t& segmentIndex, uint32_t& offset)
+  {
+    uint64_t biased = uint64_t (slot) + (1u << s_firstSegmentBits);
+    uint32_t top = 63 - __builtin_clzll (biased);
+    segmentIndex = top - s_firstSegmentBits;
+    offset = uint32_t (biased - (uint64_t (1) << top));
+  }
+
+  static uint64_t
+  hashOf (const char* s, size_t length)
+  {
+    // 8 bytes per step, multiply and fold
+    uint64_t h = 0x9E3779B97F4A7C15ULL ^ length;
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8)
+      {
+	uint64_t w;
+	memcpy (&w, s + i, 8);
+	h = (h ^ w) * 0xFF51AFD7ED558CCDULL;
+	h ^= h >> 32;
+      }
+    uint64_t tail = 0;
+    memcpy (&tail, s + i, length - i);
+    h = (h ^ tail) * 0xC4CEB9FE1A85EC53ULL;
+    return h ^ (h >> 29);
+  }
+
+  ///
+  /// Memory a myString of length chars takes: the object, plus a heap block beyond m_local
+  ///
+  static uint64_t
+  myStringBytes (size_t length)
+  {
+    return sizeof(myString) + (length + 1 > myString::s_localCapacity ? length + 1 : 0);
+  }
+};
+
+#endif /* INTERNPOOL_H_ */
@@ -0,0 +1,138 @@
+/****************************************************************************************************/
+/*                                                                                                  */
+/* @module        : Cpp 11 features examples                                                        */
+/* @file          : lazy.h                                                                          */
+/* @brief         : Construct on first use, lock free once constructed                              */
+/* @input         :                                                                                 */
+/* @outpu         :                                                                                 */
+/* @date          : 16-October-2026                                                                 */
+/* @author        : Pratik Patil                                                                    */
+/* License        :                                                                                 */
+/*               Copyright (C) 2017  Pratik Patil                                                   */
+/*                                                                                                  */
+/*               This program is free software: you can redistribute it and/or modify               */
+/*               it under the terms of the GNU General Public License Version 3 as published by     */
+/*               the Free Software Foundation.                                                      */
+/*                                                                                                  */
+/*               This program is distributed in the hope that it will be useful,                    */
+/*               but WITHOUT ANY WARRANTY; without even the implied warranty of                     */
+/*               MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                      */
+/*               GNU General Public License for more details.                                       */
+/*                                                                                                  */
+/*               You should have received a copy of the GNU General Public License                  */
+/*               along with this program.  If not, see <http://www.gnu.org/licenses/>.              */
+/****************************************************************************************************/
+#ifndef LAZY_H_
+#define LAZY_H_
+
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include "functionRef.h"
+
+/*
+ * Description:
+ *   lazy<T> holds a T which is constructed the first time it is used, by the factory given to
+ *   the constructor. Parts of a big object graph nobody touches are never built, and start up
+ *   does not pay for the rest up front.
+ *
+ *     lazy<delegatingConstructor> dc ([] { return delegatingConstructor (42); });
+ *     dc->value ();     // constructed here
+ *
+ *   - Once constructed, get () is one acquire load and a compare, no lock, no read-modify-write.
+ *   - The first caller constructs, threads arriving meanwhile yield until it is done. If the
+ *     factory throws, the next call tries again.
+ *   - The factory lives in an inplaceFunction (no allocation) and is dropped after use, so its
+ *     captures are released. T is built in place from the factory's result.
+ */
+
+template<class T>
+  class lazy
+  {
+  public:
+    lazy () :
+	lazy ([]()
+	  { return T ();})
+    {
+    }
+    template<class FACTORY>
+      explicit
+      lazy (FACTORY factory) :
+	  m_state (s_empty), m_factory (std::move (factory))
+      {
+      }
+    ~lazy ()
+    {
+      if (m_state.load (std::memory_order_relaxed) == s_ready)
+	reinterpret_cast<T*> (&m_storage)->~T ();
+    }
+    lazy (const lazy&) = delete;
+    lazy&
+    operator = (const lazy&) = delete;
+
+    T&
+    get ()
+    {
+      if (m_state.load (std::memory_order_acquire) != s_ready)
+	construct ();
+      return *reinterpret_cast<T*> (&m_storage);
+    }
+    T&
+    operator * ()
+    {
+      return get ();
+    }
+    T*
+    operator -> ()
+    {
+      return &get ();
+    }
+    bool
+    constructed () const
+    {
+      return m_state.load (std::memory_order_acquire) == s_ready;
+    }
+
+  private:
+    enum : uint8_t
+    {
+      s_empty, s_constructing, s_ready
+    };
+
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type m_storage;
+    std::atomic<uint8_t> m_state;
+    inplaceFunction<T
+    ()> m_factory;
+
+    void __attribute__((noinline))
+    construct ()
+    {
+      for (;;)
+	{
+	  uint8_t state = m_state.load (std::memory_order_acquire);
+	  if (state == s_ready)
+	    return;
+	  if (state == s_empty
+	      && m_state.compare_exchange_strong (state, s_constructing, std::memory_order_acquire))
+	    {
+	      try
+		{
+		  new (&m_storage) T (m_factory ());
+		}
+	      catch (...)
+		{
+		  m_state.store (s_empty, std::memory_order_release);
+		  throw;
+		}
+	      m_factory.reset ();
+	      m_state.store (s_ready, std::memory_order_release);
+	      return;
+	    }
+	  std::this_thread::yield ();
+	}
+    }
+  };
+
+#endif /* LAZY_H_ */
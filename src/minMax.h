@@ -0,0 +1,171 @@
+/****************************************************************************************************/
+/*                                                                                                  */
+/* @module        : Cpp 11 features examples                                                        */
+/* @file          : minMax.h                                                                        */
+/* @brief         : Vectorized, multi threaded min/max reduction over arrays                        */
+/* @input         :                                                                                 */
+/* @outpu         :                                                                                 */
+/* @date          : 16-October-2026                                                                 */
+/* @author        : Pratik Patil                                                                    */
+/* License        :                                                                                 */
+/*               Copyright (C) 2017  Pratik Patil                                                   */
+/*                                                                                                  */
+/*               This program is free software: you can redistribute it and/or modify               */
+/*               it under the terms of the GNU General Public License Version 3 as published by     */
+/*               the Free Software Foundation.                                                      */
+/*                                                                                                  */
+/*               This program is distributed in the hope that it will be useful,                    */
+/*               but WITHOUT ANY WARRANTY; without even the implied warranty of                     */
+/*               MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                      */
+/*               GNU General Public License for more details.                                       */
+/*                                                                                                  */
+/*               You should have received a copy of the GNU General Public License                  */
+/*               along with this program.  If not, see <http://www.gnu.org/licenses/>.              */
+/****************************************************************************************************/
+#ifndef MINMAX_H_
+#define MINMAX_H_
+
+#include <cstddef>
+#include <mutex>
+#include "threadPool.h"
+
+/*
+ * Description:
+ *   minMax (data, n) returns the smallest and largest of n >= 1 values of int, float, double, or
+ *   any other type with operator <. Both start from data[0], so all positive or all negative input
+ *   gives the right answer.
+ *
+ *   SIMD -
+ *   The loop keeps one running min and max per lane over 64 bytes of input (16 ints, 8 doubles),
+ *   so there is no dependency from one element to the next and the compiler turns the lane loop
+ *   into pminsd/pmaxsd or minps/maxps. For int, float and double the kernel is built twice, for
+ *   AVX2 and for the baseline, and the loader picks the one the CPU can run (GCC target_clones).
+ *
+ *   Threads -
+ *   From minMaxLimits::s_minParallel elements on, the array is cut into one chunk per worker of
+ *   pool (threadPool::global () by default), each chunk is reduced into its own partial result and
+ *   the partials are merged. A pool of one worker runs the kernel on the calling thread.
+ *
+ *   NaNs in floating point input are not supported, the result is then unspecified.
+ */
+
+template<class T>
+  struct minMaxResult
+  {
+    T min;
+    T max;
+  };
+
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) && defined(__ELF__)
+#define MINMAX_CLONES __attribute__((target_clones("avx2","default")))
+#else
+#define MINMAX_CLONES
+#endif
+
+template<class T>
+  inline __attribute__((always_inline)) void
+  minMaxLanes (const T* data, size_t n, T& lo, T& hi)
+  {
+    const size_t lanes = 64 / sizeof(T) ? 64 / sizeof(T) : 1;
+    T l[lanes];
+    T h[lanes];
+    for (size_t j = 0; j < lanes; ++j)
+      {
+	l[j] = data[0];
+	h[j] = data[0];
+      }
+    size_t i = 0;
+    for (; i + lanes <= n; i += lanes)
+      for (size_t j = 0; j < lanes; ++j)
+	{
+	  T v = data[i + j];
+	  l[j] = v < l[j] ? v : l[j];
+	  h[j] = h[j] < v ? v : h[j];
+	}
+    T a = l[0];
+    T b = h[0];
+    for (size_t j = 1; j < lanes; ++j)
+      {
+	a = l[j] < a ? l[j] : a;
+	b = b < h[j] ? h[j] : b;
+      }
+    for (; i < n; ++i)
+      {
+	T v = data[i];
+	a = v < a ? v : a;
+	b = b < v ? v : b;
+      }
+    lo = a;
+    hi = b;
+  }
+
+///
+/// Single threaded reduction, overloaded so the common types get the multi versioned kernel
+///
+template<class T>
+  inline void
+  minMaxKernel (const T* data, size_t n, T& lo, T& hi)
+  {
+    minMaxLanes (data, n, lo, hi);
+  }
+MINMAX_CLONES inline void
+minMaxKernel (const int* data, size_t n, int& lo, int& hi)
+{
+  minMaxLanes (data, n, lo, hi);
+}
+MINMAX_CLONES inline void
+minMaxKernel (const float* data, size_t n, float& lo, float& hi)
+{
+  minMaxLanes (data, n, lo, hi);
+}
+MINMAX_CLONES inline void
+minMaxKernel (const double* data, size_t n, double& lo, double& hi)
+{
+  minMaxLanes (data, n, lo, hi);
+}
+
+///
+/// Tuning of minMax, below s_minParallel elements one thread is faster than waking the pool
+///
+struct minMaxLimits
+{
+  static const size_t s_minParallel = 1 << 20;
+};
+
+template<class T>
+  minMaxResult<T>
+  minMax (const T* data, size_t n, threadPool& pool = threadPool::global ())
+  {
+    minMaxResult<T> result;
+    if (n == 0)
+      {
+	result.min = result.max = T ();
+	return result;
+      }
+    size_t chunks = pool.size ();
+    const size_t minParallel = minMaxLimits::s_minParallel;
+    if (chunks <= 1 || n < minParallel)
+      {
+	minMaxKernel (data, n, result.min, result.max);
+	return result;
+      }
+    if (chunks > n / (minParallel / 4))
+      chunks = n / (minParallel / 4);
+
+    std::mutex mutex;
+    bool first = true;
+    pool.forRange (0, n, (n + chunks - 1) / chunks, [&](size_t b, size_t e)
+      {
+	minMaxResult<T> partial;
+	minMaxKernel (data + b, e - b, partial.min, partial.max);
+	std::lock_guard<std::mutex> lock (mutex);
+	if (first)
+	  result = partial;
+	result.min = partial.min < result.min ? partial.min : result.min;
+	result.max = result.max < partial.max ? partial.max : result.max;
+	first = false;
+      });
+    return result;
+  }
+
+#endif /* MINMAX_H_ */
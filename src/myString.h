@@ -0,0 +1,523 @@
+/****************************************************************************************************/
+/*                                                                                                  */
+/* @module        : Cpp 11 features examples                                                        */
+/* @file          : myString.h                                                                      */
+/* @brief         : myString, the move aware string used by the rvalue reference samples            */
+/* @input         :                                                                                 */
+/* @outpu         :                                                                                 */
+/* @date          : 16-October-2026                                                                 */
+/* @author        : Pratik Patil                                                                    */
+/* License        :                                                                                 */
+/*               Copyright (C) 2017  Pratik Patil                                                   */
+/*                                                                                                  */
+/*               This program is free software: you can redistribute it and/or modify               */
+/*               it under the terms of the GNU General Public License Version 3 as published by     */
+/*               the Free Software Foundation.                                                      */
+/*                                                                                                  */
+/*               This program is distributed in the hope that it will be useful,                    */
+/*               but WITHOUT ANY WARRANTY; without even the implied warranty of                     */
+/*               MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                      */
+/*               GNU General Public License for more details.                                       */
+/*                                                                                                  */
+/*               You should have received a copy of the GNU General Public License                  */
+/*               along with this program.  If not, see <http://www.gnu.org/licenses/>.              */
+/****************************************************************************************************/
+#ifndef MYSTRING_H_
+#define MYSTRING_H_
+
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include "myStringAllocator.h"
+#include "myStringStats.h"
+#include "scopeTrace.h"
+
+/*
+ * Description:
+ *   myString owns a '\0' terminated character buffer. m_size counts the terminating '\0', so an
+ *   empty default constructed string has m_size 0 and m_data nullptr.
+ *
+ *   Small string optimization -
+ *   Strings which fit in m_local (including the '\0') are stored inside the object itself and never
+ *   touch the allocator. Only longer strings go to the heap. Moving a small string hence copies the
+ *   few bytes from m_local, while moving a heap string just pilfers the pointer.
+ *
+ *   Assignment reuses the existing buffer whenever it is big enough for the new value.
+ *
+ *   Allocation policy -
+ *   Heap buffers come from the ALLOC policy of basicMyString (see myStringAllocator.h). myString
+ *   uses global new[]/delete[], arenaString and poolString take their buffers from a per thread
+ *   arena or size class pool instead. Concatenation can mix strings of different policies.
+ *
+ *   Concatenation -
+ *   operator + does not build a string. It returns a myStringConcat expression which only remembers
+ *   its operands. When the expression is finally assigned to (or used to construct) a myString, the
+ *   total size is computed once, one buffer is reserved and every piece is copied straight into it.
+ *   So a + b + c + d costs one allocation instead of three temporaries copying the prefix again and
+ *   again. myString operands are held by reference, hence an expression must not outlive them.
+ *
+ *   Instrumentation -
+ *   Copies, moves, concatenations, allocations and copied bytes are counted when built with
+ *   MYSTRING_STATS, see myStringStats.h. Nothing is printed. Built with SCOPE_TRACE, every
+ *   materialized concatenation is a "myString operator +" scope in the trace (scopeTrace.h).
+ */
+template<class ALLOC = newAllocator>
+  class basicMyString;
+
+///
+/// Non owning view of a '\0' terminated char array, so literals can take part in concatenation
+///
+struct myStringPiece
+{
+  const char* m_data;
+  size_t m_length;
+
+  explicit
+  myStringPiece (const char* ptr) :
+      m_data (ptr), m_length (strlen (ptr))
+  {
+  }
+  size_t
+  length () const
+  {
+    return m_length;
+  }
+  char*
+  copyTo (char* dst) const
+  {
+    memcpy (dst, m_data, m_length);
+    return dst + m_length;
+  }
+  bool
+  overlaps (const char* begin, const char* end) const
+  {
+    return m_data < end && begin < m_data + m_length;
+  }
+};
+
+template<class L, class R>
+  struct myStringConcat;
+
+///
+/// Types which can be an operand of concatenation, and how an expression stores them.
+/// myString is stored by reference, pieces and nested expressions are small and stored by value.
+///
+template<class T>
+  struct myStringOperand
+  {
+    static const bool value = false;
+  };
+template<class ALLOC>
+  struct myStringOperand<basicMyString<ALLOC> >
+  {
+    static const bool value = true;
+    typedef const basicMyString<ALLOC>& storage;
+  };
+template<>
+  struct myStringOperand<myStringPiece>
+  {
+    static const bool value = true;
+    typedef myStringPiece storage;
+  };
+template<class L, class R>
+  struct myStringOperand<myStringConcat<L, R> >
+  {
+    static const bool value = true;
+    typedef myStringConcat<L, R> storage;
+  };
+
+template<class L, class R>
+  struct myStringConcat
+  {
+    typename myStringOperand<L>::storage m_lhs;
+    typename myStringOperand<R>::storage m_rhs;
+
+    myStringConcat (const L& lhs, const R& rhs) :
+	m_lhs (lhs), m_rhs (rhs)
+    {
+    }
+    size_t
+    length () const
+    {
+      return m_lhs.length () + m_rhs.length ();
+    }
+    char*
+    copyTo (char* dst) const
+    {
+      return m_rhs.copyTo (m_lhs.copyTo (dst));
+    }
+    bool
+    overlaps (const char* begin, const char* end) const
+    {
+      return m_lhs.overlaps (begin, end) || m_rhs.overlaps (begin, end);
+    }
+  };
+
+template<class ALLOC>
+  class basicMyString
+  {
+
+  public:
+    static const size_t s_localCapacity = 24;
+
+    char* m_data;
+    size_t m_size;
+    size_t m_capacity;
+    char m_local[s_localCapacity];
+
+    basicMyString () :
+	m_data (nullptr), m_size (0), m_capacity (0)
+    {
+    }
+    basicMyString (const char* ptr) :
+	basicMyString ()
+    {
+      assign (ptr, strlen (ptr) + 1);
+    }
+    ~basicMyString ()
+    {
+      release ();
+    }
+    // Simple copy constructor
+    basicMyString (const basicMyString& str) :
+	basicMyString ()
+    {
+      MYSTRING_COUNT(copies, 1);
+      assign (str.m_data, str.m_size);
+    }
+
+    // rvalue ref
+    basicMyString (basicMyString&& str) noexcept :
+	basicMyString ()
+    {
+      MYSTRING_COUNT(moves, 1);
+      steal (str);
+    }
+
+    basicMyString&
+    operator = (const basicMyString& str)
+    {
+      MYSTRING_COUNT(copies, 1);
+      if (this != &str)
+	assign (str.m_data, str.m_size);
+      return *this;
+    }
+
+    basicMyString&
+    operator = (basicMyString&& str) noexcept
+    {
+      MYSTRING_COUNT(moves, 1);
+      if (this != &str)
+	{
+	  if (!str.isLocal () || str.m_size > m_capacity)
+	    {
+	      // The source owns a heap buffer (or ours is too small anyway), take it over.
+	      release ();
+	      steal (str);
+	    }
+	  else
+	    {
+	      // Source lives in its m_local. Copy the few bytes into the buffer we already have.
+	      memcpy (m_data, str.m_data, str.m_size);
+	      MYSTRING_COUNT(bytesCopied, str.m_size);
+	      m_size = str.m_size;
+	      str.m_size = 0;
+	    }
+	}
+      return *this;
+    }
+
+    //
+    // Materializes a concatenation expression with a single allocation
+    //
+    template<class L, class R>
+      basicMyString (const myStringConcat<L, R>& expr) :
+	  basicMyString ()
+      {
+	MYSTRING_COUNT(concatenations, 1);
+	assignConcat (expr);
+      }
+
+    template<class L, class R>
+      basicMyString&
+      operator = (const myStringConcat<L, R>& expr)
+      {
+	MYSTRING_COUNT(concatenations, 1);
+	if (m_data && expr.overlaps (m_data, m_data + m_capacity))
+	  {
+	    // Something like a = b + a, writing in place would overwrite an operand before it's read.
+	    basicMyString temp;
+	    temp.assignConcat (expr);
+	    release ();
+	    steal (temp);
+	  }
+	else
+	  assignConcat (expr);
+	return *this;
+      }
+
+    size_t
+    length () const
+    {
+      return m_size ? m_size - 1 : 0;
+    }
+    char*
+    copyTo (char* dst) const
+    {
+      size_t len = length ();
+      if (len)
+	memcpy (dst, m_data, len);
+      return dst + len;
+    }
+    bool
+    overlaps (const char* begin, const char* end) const
+    {
+      return m_data && m_data < end && begin < m_data + m_size;
+    }
+
+    bool
+    isLocal () const
+    {
+      return m_data == m_local;
+    }
+
+    ///
+    /// Makes sure buffer can hold at least capacity bytes. Contents are not preserved.
+    ///
+    void
+    reserve (size_t capacity)
+    {
+      if (capacity <= m_capacity)
+	return;
+      release ();
+      if (capacity <= s_localCapacity)
+	{
+	  m_data = m_local;
+	  m_capacity = s_localCapacity;
+	}
+      else
+	{
+	  m_data = ALLOC::allocate (capacity);
+	  MYSTRING_COUNT(allocations, 1);
+	  m_capacity = capacity;
+	}
+    }
+
+    ///
+    /// Like reserve, but keeps the first m_size bytes of the current contents.
+    ///
+    void
+    grow (size_t capacity)
+    {
+      if (capacity <= m_capacity)
+	return;
+      if (capacity <= s_localCapacity)
+	{
+	  m_data = m_local;
+	  m_capacity = s_localCapacity;
+	  return;
+	}
+      char* data = ALLOC::allocate (capacity);
+      MYSTRING_COUNT(allocations, 1);
+      if (m_size)
+	memcpy (data, m_data, m_size);
+      MYSTRING_COUNT(bytesCopied, m_size);
+      size_t size = m_size;
+      release ();
+      m_data = data;
+      m_size = size;
+      m_capacity = capacity;
+    }
+
+    ///
+    /// Replaces contents with size bytes from ptr (size includes the '\0').
+    ///
+    void
+    assign (const char* ptr, size_t size)
+    {
+      if (size == 0)
+	{
+	  m_size = 0;
+	  if (m_data)
+	    m_data[0] = '\0';
+	  return;
+	}
+      reserve (size);
+      memmove (m_data, ptr, size);
+      MYSTRING_COUNT(bytesCopied, size);
+      m_size = size;
+    }
+
+  private:
+    template<class L, class R>
+      void
+      assignConcat (const myStringConcat<L, R>& expr)
+      {
+	TRACE_SCOPE ("myString operator +");
+	size_t size = expr.length () + 1;
+	reserve (size);
+	*expr.copyTo (m_data) = '\0';
+	m_size = size;
+	MYSTRING_COUNT(bytesCopied, size);
+      }
+
+    void
+    release ()
+    {
+      if (m_data && !isLocal ())
+	ALLOC::deallocate (m_data, m_capacity);
+      m_data = nullptr;
+      m_size = 0;
+      m_capacity = 0;
+    }
+
+    // Takes over contents of str. Expects this to be empty.
+    void
+    steal (basicMyString& str)
+    {
+      if (str.isLocal ())
+	{
+	  m_data = m_local;
+	  m_capacity = s_localCapacity;
+	  memcpy (m_local, str.m_local, str.m_size);
+	  MYSTRING_COUNT(bytesCopied, str.m_size);
+	}
+      else
+	{
+	  m_data = str.m_data;
+	  m_capacity = str.m_capacity;
+	}
+      m_size = str.m_size;
+      str.m_data = nullptr;
+      str.m_size = 0;
+      str.m_capacity = 0;
+    }
+  };
+
+typedef basicMyString<> myString;
+typedef basicMyString<arenaAllocator> arenaString;
+typedef basicMyString<poolAllocator> poolString;
+
+/*
+ * myStringBuilder -
+ *   Building a long string with repeated s = s + piece copies everything built so far on each step,
+ *   so total work grows quadratically. myStringBuilder appends into one buffer whose capacity grows
+ *   geometrically (doubling), so each append is amortized O(1). The buffer is a myString from the
+ *   start, hence release() just moves it out. The result is never copied once more to make it
+ *   contiguous, as a rope of chunks would have to.
+ */
+template<class ALLOC = newAllocator>
+  class basicMyStringBuilder
+  {
+  public:
+    explicit
+    basicMyStringBuilder (size_t capacity = 0) :
+	m_length (0)
+    {
+      if (capacity)
+	m_string.grow (capacity + 1);
+    }
+
+    basicMyStringBuilder&
+    append (const char* ptr, size_t length)
+    {
+      char* dst = makeRoom (length);
+      memcpy (dst, ptr, length);
+      MYSTRING_COUNT(bytesCopied, length);
+      m_length += length;
+      return *this;
+    }
+    basicMyStringBuilder&
+    append (const char* ptr)
+    {
+      return append (ptr, strlen (ptr));
+    }
+    template<class A>
+      basicMyStringBuilder&
+      append (const basicMyString<A>& str)
+      {
+	return append (str.m_data, str.length ());
+      }
+    template<class L, class R>
+      basicMyStringBuilder&
+      append (const myStringConcat<L, R>& expr)
+      {
+	size_t length = expr.length ();
+	expr.copyTo (makeRoom (length));
+	m_length += length;
+	MYSTRING_COUNT(bytesCopied, length);
+	return *this;
+      }
+
+    template<class T>
+      basicMyStringBuilder&
+      operator += (const T& value)
+      {
+	return append (value);
+      }
+
+    size_t
+    length () const
+    {
+      return m_length;
+    }
+
+    ///
+    /// Hands the built string over without copying it. The builder is empty afterwards.
+    ///
+    basicMyString<ALLOC>
+    release ()
+    {
+      makeRoom (0)[0] = '\0';
+      m_string.m_size = m_length + 1;
+      m_length = 0;
+      return std::move (m_string);
+    }
+
+  private:
+    basicMyString<ALLOC> m_string;
+    size_t m_length;
+
+    // Returns where the next length bytes go, keeping one byte spare for the '\0'
+    char*
+    makeRoom (size_t length)
+    {
+      size_t needed = m_length + length + 1;
+      if (needed > m_string.m_capacity)
+	{
+	  size_t capacity = m_string.m_capacity * 2;
+	  m_string.m_size = m_length;
+	  m_string.grow (capacity > needed ? capacity : needed);
+	}
+      return m_string.m_data + m_length;
+    }
+  };
+
+typedef basicMyStringBuilder<> myStringBuilder;
+
+///
+/// operator + for every combination of myString, literal and expression operands
+///
+template<class L, class R>
+  inline typename std::enable_if<myStringOperand<L>::value && myStringOperand<R>::value,
+      myStringConcat<L, R> >::type
+  operator + (const L& lhs, const R& rhs)
+  {
+    return myStringConcat<L, R> (lhs, rhs);
+  }
+
+template<class L>
+  inline typename std::enable_if<myStringOperand<L>::value, myStringConcat<L, myStringPiece> >::type
+  operator + (const L& lhs, const char* rhs)
+  {
+    return myStringConcat<L, myStringPiece> (lhs, myStringPiece (rhs));
+  }
+
+template<class R>
+  inline typename std::enable_if<myStringOperand<R>::value, myStringConcat<myStringPiece, R> >::type
+  operator + (const char* lhs, const R& rhs)
+  {
+    return myStringConcat<myStringPiece, R> (myStringPiece (lhs), rhs);
+  }
+
+#endif /* MYSTRING_H_ */
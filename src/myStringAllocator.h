@@ -0,0 +1,308 @@
+/****************************************************************************************************/
+/*                                                                                                  */
+/* @module        : Cpp 11 features examples                                                        */
+/* @file          : myStringAllocator.h                                                             */
+/* @brief         : Allocation policies for myString: global heap, arena and pool                   */
+/* @input         :                                                                                 */
+/* @outpu         :                                                                                 */
+/* @date          : 16-October-2026                                                                 */
+/* @author        : Pratik Patil                                                                    */
+/* License        :                                                                                 */
+/*               Copyright (C) 2017  Pratik Patil                                                   */
+/*                                                                                                  */
+/*               This program is free software: you can redistribute it and/or modify               */
+/*               it under the terms of the GNU General Public License Version 3 as published by     */
+/*               the Free Software Foundation.                                                      */
+/*                                                                                                  */
+/*               This program is distributed in the hope that it will be useful,                    */
+/*               but WITHOUT ANY WARRANTY; without even the implied warranty of                     */
+/*               MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                      */
+/*               GNU General Public License for more details.                                       */
+/*                                                                                                  */
+/*               You should have received a copy of the GNU General Public License                  */
+/*               along with this program.  If not, see <http://www.gnu.org/licenses/>.              */
+/****************************************************************************************************/
+#ifndef MYSTRINGALLOCATOR_H_
+#define MYSTRINGALLOCATOR_H_
+
+#include <cstddef>
+#include <vector>
+
+/*
+ * Description:
+ *   basicMyString<ALLOC> gets its heap buffers from ALLOC. A policy is a type with two static
+ *   functions:
+ *
+ *     static char* allocate (size_t size);
+ *     static void deallocate (char* p, size_t size);  // size is what was passed to allocate
+ *
+ *   newAllocator     - global new[]/delete[]. This is what myString uses.
+ *   arenaAllocator   - bump pointer allocation from the current myStringArena. deallocate does
+ *                      nothing, the memory of all strings comes back in one reset(). By default
+ *                      the current arena is a thread local one, myStringArena::scope switches to
+ *                      another arena, e.g. one per request.
+ *   poolAllocator    - per thread free lists of power of two size classes, so buffers are recycled
+ *                      without going to the global allocator and its lock.
+ */
+
+struct newAllocator
+{
+  static char*
+  allocate (size_t size)
+  {
+    return new char[size];
+  }
+  static void
+  deallocate (char* p, size_t)
+  {
+    delete[] p;
+  }
+};
+
+///
+/// Bump pointer arena. Memory is handed out from big blocks and only reclaimed by reset(), which
+/// keeps the blocks around for the next round. Strings allocated from an arena must not be used
+/// after it is reset or destroyed.
+///
+class myStringArena
+{
+public:
+  explicit
+  myStringArena (size_t blockSize = 64 * 1024) :
+      m_blockSize (blockSize), m_block (0), m_offset (0)
+  {
+  }
+  ~myStringArena ()
+  {
+    for (char* block : m_blocks)
+      delete[] block;
+    freeLarge ();
+  }
+  myStringArena (const myStringArena&) = delete;
+  myStringArena&
+  operator = (const myStringArena&) = delete;
+
+  char*
+  allocate (size_t size)
+  {
+    // keep every allocation 8 byte aligned, so copying into it can use whole words
+    size = (size + 7) & ~size_t (7);
+    if (size > m_blockSize / 4)
+      {
+	// Big requests would waste most of a block, they get their own
+	m_large.push_back (new char[size]);
+	return m_large.back ();
+      }
+    if (m_blocks.empty () || m_offset + size > m_blockSize)
+      nextBlock ();
+    char* p = m_blocks[m_block] + m_offset;
+    m_offset += size;
+    return p;
+  }
+
+  ///
+  /// Releases everything allocated so far in one go
+  ///
+  void
+  reset ()
+  {
+    m_block = 0;
+    m_offset = 0;
+    freeLarge ();
+  }
+
+  size_t
+  bytesReserved () const
+  {
+    return m_blocks.size () * m_blockSize;
+  }
+
+  ///
+  /// Arena used by arenaAllocator on the calling thread
+  ///
+  static myStringArena&
+  current ()
+  {
+    return *currentSlot ();
+  }
+
+  ///
+  /// Makes arena the current one of this thread for the lifetime of the scope object
+  ///
+  class scope
+  {
+  public:
+    explicit
+    scope (myStringArena& arena) :
+	m_previous (currentSlot ())
+    {
+      currentSlot () = &arena;
+    }
+    ~scope ()
+    {
+      currentSlot () = m_previous;
+    }
+    scope (const scope&) = delete;
+    scope&
+    operator = (const scope&) = delete;
+  private:
+    myStringArena* m_previous;
+  };
+
+private:
+  size_t m_blockSize;
+  std::vector<char*> m_blocks;
+  std::vector<char*> m_large;
+  size_t m_block;
+  size_t m_offset;
+
+  void
+  nextBlock ()
+  {
+    if (!m_blocks.empty ())
+      ++m_block;
+    if (m_block == m_blocks.size ())
+      m_blocks.push_back (new char[m_blockSize]);
+    m_offset = 0;
+  }
+  void
+  freeLarge ()
+  {
+    for (char* p : m_large)
+      delete[] p;
+    m_large.clear ();
+  }
+
+  static myStringArena*&
+  currentSlot ()
+  {
+    static thread_local myStringArena threadArena;
+    static thread_local myStringArena* current = &threadArena;
+    return current;
+  }
+};
+
+struct arenaAllocator
+{
+  static char*
+  allocate (size_t size)
+  {
+    return myStringArena::current ().allocate (size);
+  }
+  static void
+  deallocate (char*, size_t)
+  {
+  }
+};
+
+///
+/// Size class pool. Requests up to s_maxSize are rounded up to a power of two and freed buffers
+/// are kept on a free list per class for reuse. Every buffer is a separate heap block, so a string
+/// may be freed on another thread than the one which allocated it; it just ends up in that
+/// thread's pool.
+///
+class myStringPool
+{
+public:
+  static const size_t s_minSize = 32;
+  static const size_t s_maxSize = 4096;
+  static const size_t s_classes = 8;      // 32, 64, ... 4096
+  static const size_t s_maxCached = 1024; // per class, the rest goes back to the heap
+
+  myStringPool ()
+  {
+    for (size_t i = 0; i < s_classes; ++i)
+      {
+	m_free[i] = nullptr;
+	m_cached[i] = 0;
+      }
+  }
+  ~myStringPool ()
+  {
+    for (size_t i = 0; i < s_classes; ++i)
+      while (m_free[i])
+	{
+	  node* n = m_free[i];
+	  m_free[i] = n->next;
+	  delete[] reinterpret_cast<char*> (n);
+	}
+  }
+  myStringPool (const myStringPool&) = delete;
+  myStringPool&
+  operator = (const myStringPool&) = delete;
+
+  char*
+  allocate (size_t size)
+  {
+    if (size > s_maxSize)
+      return new char[size];
+    size_t c = sizeClass (size);
+    if (node* n = m_free[c])
+      {
+	m_free[c] = n->next;
+	--m_cached[c];
+	return reinterpret_cast<char*> (n);
+      }
+    return new char[s_minSize << c];
+  }
+
+  void
+  deallocate (char* p, size_t size)
+  {
+    if (size > s_maxSize)
+      {
+	delete[] p;
+	return;
+      }
+    size_t c = sizeClass (size);
+    if (m_cached[c] == s_maxCached)
+      {
+	delete[] p;
+	return;
+      }
+    node* n = reinterpret_cast<node*> (p);
+    n->next = m_free[c];
+    m_free[c] = n;
+    ++m_cached[c];
+  }
+
+  static myStringPool&
+  threadLocal ()
+  {
+    static thread_local myStringPool pool;
+    return pool;
+  }
+
+private:
+  struct node
+  {
+    node* next;
+  };
+  node* m_free[s_classes];
+  size_t m_cached[s_classes];
+
+  static size_t
+  sizeClass (size_t size)
+  {
+    size_t c = 0;
+    while ((s_minSize << c) < size)
+      ++c;
+    return c;
+  }
+};
+
+struct poolAllocator
+{
+  static char*
+  allocate (size_t size)
+  {
+    return myStringPool::threadLocal ().allocate (size);
+  }
+  static void
+  deallocate (char* p, size_t size)
+  {
+    myStringPool::threadLocal ().deallocate (p, size);
+  }
+};
+
+#endif /* MYSTRINGALLOCATOR_H_ */
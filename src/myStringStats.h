@@ -0,0 +1,188 @@
+/****************************************************************************************************/
+/*                                                                                                  */
+/* @module        : Cpp 11 features examples                                                        */
+/* @file          : myStringStats.h                                                                 */
+/* @brief         : Optional per thread copy/move/allocation counters for myString                  */
+/* @input         :                                                                                 */
+/* @outpu         :                                                                                 */
+/* @date          : 16-October-2026                                                                 */
+/* @author        : Pratik Patil                                                                    */
+/* License        :                                                                                 */
+/*               Copyright (C) 2017  Pratik Patil                                                   */
+/*                                                                                                  */
+/*               This program is free software: you can redistribute it and/or modify               */
+/*               it under the terms of the GNU General Public License Version 3 as published by     */
+/*               the Free Software Foundation.                                                      */
+/*                                                                                                  */
+/*               This program is distributed in the hope that it will be useful,                    */
+/*               but WITHOUT ANY WARRANTY; without even the implied warranty of                     */
+/*               MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                      */
+/*               GNU General Public License for more details.                                       */
+/*                                                                                                  */
+/*               You should have received a copy of the GNU General Public License                  */
+/*               along with this program.  If not, see <http://www.gnu.org/licenses/>.              */
+/****************************************************************************************************/
+#ifndef MYSTRINGSTATS_H_
+#define MYSTRINGSTATS_H_
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+/*
+ * Description:
+ *   myString used to print a line to std::cout from every constructor to show whether it was
+ *   copied or moved. That costs much more than the copy it reports and makes all threads wait on
+ *   the stream lock. Instead it now bumps counters through MYSTRING_COUNT.
+ *
+ *   Counters are compiled in only when MYSTRING_STATS is defined (e.g. -DMYSTRING_STATS), otherwise
+ *   MYSTRING_COUNT expands to nothing and snapshot() reports zeros.
+ *
+ *   Each thread owns a block of counters. Only that thread writes them, so an increment is a relaxed
+ *   load and store, no locked instruction. snapshot() adds up the blocks of all running threads plus
+ *   whatever threads that already exited left behind.
+ */
+
+///
+/// Plain copy of the counters at some point in time
+///
+struct myStringCounters
+{
+  uint64_t copies;
+  uint64_t moves;
+  uint64_t concatenations;
+  uint64_t allocations;
+  uint64_t bytesCopied;
+
+  myStringCounters
+  operator - (const myStringCounters& rhs) const
+  {
+    myStringCounters d =
+      { copies - rhs.copies, moves - rhs.moves, concatenations - rhs.concatenations, allocations
+	  - rhs.allocations, bytesCopied - rhs.bytesCopied };
+    return d;
+  }
+};
+
+inline std::ostream&
+operator << (std::ostream& os, const myStringCounters& c)
+{
+  return os << "copies " << c.copies << ", moves " << c.moves << ", concatenations "
+      << c.concatenations << ", allocations " << c.allocations << ", bytes copied " << c.bytesCopied;
+}
+
+class myStringStats
+{
+public:
+  enum counter
+  {
+    copies, moves, concatenations, allocations, bytesCopied, counterCount
+  };
+
+#ifdef MYSTRING_STATS
+  static const bool enabled = true;
+#else
+  static const bool enabled = false;
+#endif
+
+  static void
+  add (counter c, uint64_t n)
+  {
+    std::atomic<uint64_t>& value = threadBlock ().m_values[c];
+    value.store (value.load (std::memory_order_relaxed) + n, std::memory_order_relaxed);
+  }
+
+  static myStringCounters
+  snapshot ()
+  {
+    uint64_t sum[counterCount];
+    registry& r = theRegistry ();
+    std::lock_guard<std::mutex> lock (r.m_mutex);
+    for (int c = 0; c < counterCount; ++c)
+      {
+	sum[c] = r.m_retired[c];
+	for (block* b : r.m_blocks)
+	  sum[c] += b->m_values[c].load (std::memory_order_relaxed);
+      }
+    myStringCounters s =
+      { sum[copies], sum[moves], sum[concatenations], sum[allocations], sum[bytesCopied] };
+    return s;
+  }
+
+  static void
+  dump (std::ostream& os)
+  {
+    if (enabled)
+      os << "myString : " << snapshot () << std::endl;
+    else
+      os << "myString : counters disabled, build with -DMYSTRING_STATS" << std::endl;
+  }
+
+private:
+  struct block;
+  struct registry
+  {
+    std::mutex m_mutex;
+    std::vector<block*> m_blocks;
+    uint64_t m_retired[counterCount];
+
+    registry ()
+    {
+      for (int c = 0; c < counterCount; ++c)
+	m_retired[c] = 0;
+    }
+  };
+
+  struct block
+  {
+    std::atomic<uint64_t> m_values[counterCount];
+
+    block ()
+    {
+      for (int c = 0; c < counterCount; ++c)
+	m_values[c].store (0, std::memory_order_relaxed);
+      registry& r = theRegistry ();
+      std::lock_guard<std::mutex> lock (r.m_mutex);
+      r.m_blocks.push_back (this);
+    }
+    ~block ()
+    {
+      registry& r = theRegistry ();
+      std::lock_guard<std::mutex> lock (r.m_mutex);
+      for (int c = 0; c < counterCount; ++c)
+	r.m_retired[c] += m_values[c].load (std::memory_order_relaxed);
+      for (size_t i = 0; i < r.m_blocks.size (); ++i)
+	if (r.m_blocks[i] == this)
+	  {
+	    r.m_blocks[i] = r.m_blocks.back ();
+	    r.m_blocks.pop_back ();
+	    break;
+	  }
+    }
+  };
+
+  static registry&
+  theRegistry ()
+  {
+    // never destroyed, thread blocks may retire during static destruction
+    static registry* r = new registry ();
+    return *r;
+  }
+
+  static block&
+  threadBlock ()
+  {
+    static thread_local block b;
+    return b;
+  }
+};
+
+#ifdef MYSTRING_STATS
+#define MYSTRING_COUNT(counter, n) myStringStats::add (myStringStats::counter, n)
+#else
+#define MYSTRING_COUNT(counter, n) ((void) 0)
+#endif
+
+#endif /* MYSTRINGSTATS_H_ */
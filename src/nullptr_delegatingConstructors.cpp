@@ -23,6 +23,9 @@
 /*               along with this program.  If not, see <http://www.gnu.org/licenses/>.              */
 /****************************************************************************************************/
 #include <iostream>
+#include "batchBuilder.h"
+#include "lazy.h"
+#include "tagDispatcher.h"
 
 /*
  * Description :
@@ -50,6 +53,17 @@ funct (char* a)
   std::cout << "Char pointer is Passed :" << std::endl;
 }
 
+///
+/// The same choice made through tags: each handler is bound to a tag type and the dispatcher
+/// picks it at compile time, see tagDispatcher.h
+///
+struct intTag
+{
+};
+struct pointerTag
+{
+};
+
 /*
  * Delegating Constructors -
  *   In C++11 a constructor may call another constructor of the same class through initializer list
@@ -62,18 +76,28 @@ funct (char* a)
 class delegatingConstructor
 {
 public:
+  // Printing from a constructor is slow and serializes threads on the stream. The demo in main
+  // switches it on, objects built in bulk stay quiet.
+  static bool s_trace;
+
   delegatingConstructor () :
       delegatingConstructor (0)
   {
     //      delegatingConstructor(0);      // If we were using older c++, this is how we do it.
-    std::cout << "delegatingConstructor()" << std::endl;
+    if (s_trace)
+      std::cout << "delegatingConstructor()" << std::endl;
   }
-  delegatingConstructor (int v)
+  delegatingConstructor (int v) :
+      m_value (v)
   {
-    std::cout << "delegatingConstructor(int)" << std::endl;
+    if (s_trace)
+      std::cout << "delegatingConstructor(int)" << std::endl;
   }
+  int m_value;
 };
 
+bool delegatingConstructor::s_trace = false;
+
 int
 main (int argc, char* argv[])
 {
@@ -81,9 +105,31 @@ main (int argc, char* argv[])
   //funct (NULL);  // compilation error
   funct (nullptr); // compiles
 
+  auto dispatcher = makeTagDispatcher (onTag<intTag> ([](int a)
+    { std::cout << "intTag handler : " << a << std::endl;}), onTag<pointerTag> ([](char* a)
+    { std::cout << "pointerTag handler : " << (a ? a : "nullptr") << std::endl;}));
+  dispatcher (intTag (), 0);
+  dispatcher (pointerTag (), nullptr);
+
   // Here we are invoking default constructor, but as we have delegated construction to parameterized
   // constructor, object construction is completed by delegated constructor and then body of default
   // constructor gets executed. we can see this by the order in which constructors are called.
+  delegatingConstructor::s_trace = true;
   delegatingConstructor dc;
+  delegatingConstructor::s_trace = false;
+
+  // Nothing is constructed until the first use ...
+  lazy<delegatingConstructor> later ([]()
+    { return delegatingConstructor (42);});
+  std::cout << "lazy constructed : " << later.constructed () << std::endl;
+  std::cout << "lazy value : " << later->m_value << ", constructed : " << later.constructed ()
+      << std::endl;
+
+  // ... and many objects are built in place, in one allocation
+  batchBuilder<delegatingConstructor> nodes;
+  nodes.generate (10000, [](size_t i)
+    { return delegatingConstructor (int (i));});
+  std::cout << "batch of " << nodes.size () << ", last value : " << nodes[9999].m_value
+      << std::endl;
   return 0;
 }
@@ -0,0 +1,373 @@
+/****************************************************************************************************/
+/*                                                                                                  */
+/* @module        : Cpp 11 features examples                                                        */
+/* @file          : objectPool.h                                                                    */
+/* @brief         : Recycles objects through a lock free free list and per thread caches            */
+/* @input         :                                                                                 */
+/* @outpu         :                                                                                 */
+/* @date          : 16-October-2026                                                                 */
+/* @author        : Pratik Patil                                                                    */
+/* License        :                                                                                 */
+/*               Copyright (C) 2017  Pratik Patil                                                   */
+/*                                                                                                  */
+/*               This program is free software: you can redistribute it and/or modify               */
+/*               it under the terms of the GNU General Public License Version 3 as published by     */
+/*               the Free Software Foundation.                                                      */
+/*                                                                                                  */
+/*               This program is distributed in the hope that it will be useful,                    */
+/*               but WITHOUT ANY WARRANTY; without even the implied warranty of                     */
+/*               MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                      */
+/*               GNU General Public License for more details.                                       */
+/*                                                                                                  */
+/*               You should have received a copy of the GNU General Public License                  */
+/*               along with this program.  If not, see <http://www.gnu.org/licenses/>.              */
+/****************************************************************************************************/
+#ifndef OBJECTPOOL_H_
+#define OBJECTPOOL_H_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <vector>
+#include "uniqueHandle.h"
+
+/*
+ * Description:
+ *   Objects which can't be copied (deletedCopyStruct and friends) are usually created with new and
+ *   deleted again as soon as the work item is done. objectPool<T> keeps them instead: release()
+ *   puts an object back, acquire() hands out one that is already constructed, so the steady state
+ *   does no allocation and runs no constructor.
+ *
+ *   - acquire() returns a lease, a uniqueHandle which gives the object back to the pool when it
+ *     goes out of scope. Leases are move only and must not outlive the pool.
+ *   - Every thread keeps a small cache of free objects per pool, so acquire/release normally touch
+ *     no shared memory at all. A full cache hands half of its objects to the pool's free list, an
+ *     empty one takes from it.
+ *   - The shared free list is a lock free stack. Its head is a 32 bit object index plus a 32 bit
+ *     tag bumped on every change, so one compare and swap detects a head that was popped and
+ *     pushed back in between (ABA). Objects are never freed while the pool lives, which makes
+ *     reading the next index of a head that is just being popped by another thread safe.
+ *   - Objects are created in blocks of s_blockSize; only creating a new block takes a lock.
+ *   - create constructs an object at the given address (default: T ()), recycle (optional) resets
+ *     an object before it is reused.
+ *
+ *   Objects still sitting in another thread's cache when the pool is destroyed are destroyed once
+ *   that thread meets a new pool of T, or exits.
+ */
+
+template<class T>
+  class objectPool
+  {
+    struct state;
+
+  public:
+    static const uint32_t s_blockSize = 256;
+    static const uint32_t s_maxBlocks = 4096;
+    static const uint32_t s_cacheSize = 32;
+
+    struct giveBack
+    {
+      objectPool* pool;
+
+      static T*
+      invalid ()
+      {
+	return nullptr;
+      }
+      void
+      operator () (T* object) const
+      {
+	pool->release (object);
+      }
+    };
+    typedef uniqueHandle<T*, giveBack> lease;
+
+    explicit
+    objectPool (std::function<void
+    (void*)> create = defaultCreate, std::function<void
+    (T&)> recycle = nullptr) :
+	m_state (std::make_shared<state> ())
+    {
+      m_state->create = std::move (create);
+      m_state->recycle = std::move (recycle);
+    }
+    ~objectPool ()
+    {
+      m_state->alive.store (false, std::memory_order_release);
+      threadCaches::local ().drop (m_state.get ());
+    }
+    objectPool (const objectPool&) = delete;
+    objectPool&
+    operator = (const objectPool&) = delete;
+
+    lease
+    acquire ()
+    {
+      return lease (acquireRaw (), giveBack
+	{ this });
+    }
+
+    ///
+    /// Like acquire, the caller has to give the object back with release
+    ///
+    T*
+    acquireRaw ()
+    {
+      cache& c = threadCaches::local ().find (m_state);
+      uint32_t index;
+      if (c.count)
+	index = c.items[--c.count];
+      else if (!m_state->pop (index))
+	index = m_state->fresh ();
+      return m_state->at (index)->object ();
+    }
+
+    void
+    release (T* object)
+    {
+      if (m_state->recycle)
+	m_state->recycle (*object);
+      cache& c = threadCaches::local ().find (m_state);
+      if (c.count == s_cacheSize)
+	{
+	  c.count -= s_cacheSize / 2;
+	  m_state->push (c.items + c.count, s_cacheSize / 2);
+	}
+      c.items[c.count++] = node::of (object)->index;
+    }
+
+    ///
+    /// Number of objects constructed so far
+    ///
+    size_t
+    created () const
+    {
+      return m_state->created.load (std::memory_order_relaxed);
+    }
+
+  private:
+    struct node
+    {
+      typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+      std::atomic<uint32_t> next;
+      uint32_t index;
+      bool live;
+
+      T*
+      object ()
+      {
+	return reinterpret_cast<T*> (&storage);
+      }
+      static node*
+      of (T* object)
+      {
+	return reinterpret_cast<node*> (object);
+      }
+    };
+
+    struct state
+    {
+      std::atomic<uint64_t> head;
+      std::atomic<uint32_t> created;
+      std::atomic<bool> alive;
+      std::atomic<node*> blocks[s_maxBlocks];
+      std::mutex grow;
+      std::function<void
+      (void*)> create;
+      std::function<void
+      (T&)> recycle;
+
+      state () :
+	  head (0), created (0), alive (true)
+      {
+	for (std::atomic<node*>& b : blocks)
+	  b.store (nullptr, std::memory_order_relaxed);
+      }
+      ~state ()
+      {
+	for (std::atomic<node*>& b : blocks)
+	  if (node* block = b.load (std::memory_order_relaxed))
+	    {
+	      for (uint32_t i = 0; i < s_blockSize; ++i)
+		if (block[i].live)
+		  block[i].object ()->~T ();
+	      delete[] block;
+	    }
+      }
+
+      node*
+      at (uint32_t index)
+      {
+	return blocks[index / s_blockSize].load (std::memory_order_acquire) + index % s_blockSize;
+      }
+
+      ///
+      /// Pushes count indices in one go: they are chained first, then the head swings once
+      ///
+      void
+      push (const uint32_t* indices, uint32_t count)
+      {
+	for (uint32_t i = 0; i + 1 < count; ++i)
+	  at (indices[i])->next.store (indices[i + 1] + 1, std::memory_order_relaxed);
+	node* last = at (indices[count - 1]);
+	uint64_t old = head.load (std::memory_order_relaxed);
+	do
+	  last->next.store (uint32_t (old), std::memory_order_relaxed);
+	while (!head.compare_exchange_weak (old, tagged (old, indices[0] + 1), std::memory_order_release,
+					    std::memory_order_relaxed));
+      }
+
+      bool
+      pop (uint32_t& index)
+      {
+	uint64_t old = head.load (std::memory_order_acquire);
+	for (;;)
+	  {
+	    uint32_t top = uint32_t (old);
+	    if (!top)
+	      return false;
+	    uint32_t next = at (top - 1)->next.load (std::memory_order_relaxed);
+	    if (head.compare_exchange_weak (old, tagged (old, next), std::memory_order_acquire,
+					    std::memory_order_acquire))
+	      {
+		index = top - 1;
+		return true;
+	      }
+	  }
+      }
+
+      uint32_t
+      fresh ()
+      {
+	uint32_t index = created.fetch_add (1, std::memory_order_relaxed);
+	if (index >= s_blockSize * s_maxBlocks)
+	  throw std::bad_alloc ();
+	std::atomic<node*>& block = blocks[index / s_blockSize];
+	if (!block.load (std::memory_order_acquire))
+	  {
+	    std::lock_guard<std::mutex> lock (grow);
+	    if (!block.load (std::memory_order_relaxed))
+	      {
+		node* nodes = new node[s_blockSize];
+		for (uint32_t i = 0; i < s_blockSize; ++i)
+		  nodes[i].live = false;
+		block.store (nodes, std::memory_order_release);
+	      }
+	  }
+	node* n = at (index);
+	n->index = index;
+	create (&n->storage);
+	n->live = true;
+	return index;
+      }
+
+      static uint64_t
+      tagged (uint64_t old, uint32_t top)
+      {
+	return (((old >> 32) + 1) << 32) | top;
+      }
+    };
+
+    struct cache
+    {
+      std::shared_ptr<state> owner;
+      uint32_t count;
+      uint32_t items[s_cacheSize];
+
+      void
+      flush ()
+      {
+	if (count)
+	  owner->push (items, count);
+	count = 0;
+      }
+    };
+
+    ///
+    /// The caches of one thread for all pools of T. A cache keeps its pool's objects alive, so a
+    /// thread exiting after the pool is gone still has somewhere to put them back.
+    ///
+    struct threadCaches
+    {
+      std::vector<std::unique_ptr<cache>> caches;
+      cache* last = nullptr;
+
+      ~threadCaches ()
+      {
+	for (std::unique_ptr<cache>& c : caches)
+	  c->flush ();
+      }
+
+      cache&
+      find (const std::shared_ptr<state>& owner)
+      {
+	if (last && last->owner == owner)
+	  return *last;
+	for (std::unique_ptr<cache>& c : caches)
+	  if (c->owner == owner)
+	    return *(last = c.get ());
+	prune ();
+	caches.emplace_back (new cache
+	  { owner, 0, {} });
+	return *(last = caches.back ().get ());
+      }
+
+      void
+      drop (state* owner)
+      {
+	for (size_t i = 0; i < caches.size (); ++i)
+	  if (caches[i]->owner.get () == owner)
+	    {
+	      caches[i]->flush ();
+	      caches.erase (caches.begin () + i);
+	      last = nullptr;
+	      return;
+	    }
+      }
+
+      ///
+      /// Lets go of the caches of pools destroyed meanwhile
+      ///
+      void
+      prune ()
+      {
+	for (size_t i = 0; i < caches.size ();)
+	  if (!caches[i]->owner->alive.load (std::memory_order_acquire))
+	    {
+	      caches[i]->flush ();
+	      caches.erase (caches.begin () + i);
+	      last = nullptr;
+	    }
+	  else
+	    ++i;
+      }
+
+      static threadCaches&
+      local ()
+      {
+	static thread_local threadCaches caches;
+	return caches;
+      }
+    };
+
+    std::shared_ptr<state> m_state;
+
+    static void
+    defaultCreate (void* where)
+    {
+      new (where) T ();
+    }
+  };
+
+template<class T>
+  const uint32_t objectPool<T>::s_blockSize;
+template<class T>
+  const uint32_t objectPool<T>::s_maxBlocks;
+template<class T>
+  const uint32_t objectPool<T>::s_cacheSize;
+
+#endif /* OBJECTPOOL_H_ */
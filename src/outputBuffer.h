@@ -0,0 +1,449 @@
+/****************************************************************************************************/
+/*                                                                                                  */
+/* @module        : Cpp 11 features examples                                                        */
+/* @file          : outputBuffer.h                                                                  */
+/* @brief         : Buffered output with fast number formatting and an async writer                 */
+/* @input         :                                                                                 */
+/* @outpu         :                                                                                 */
+/* @date          : 16-October-2026                                                                 */
+/* @author        : Pratik Patil                                                                    */
+/* License        :                                                                                 */
+/*               Copyright (C) 2017  Pratik Patil                                                   */
+/*                                                                                                  */
+/*               This program is free software: you can redistribute it and/or modify               */
+/*               it under the terms of the GNU General Public License Version 3 as published by     */
+/*               the Free Software Foundation.                                                      */
+/*                                                                                                  */
+/*               This program is distributed in the hope that it will be useful,                    */
+/*               but WITHOUT ANY WARRANTY; without even the implied warranty of                     */
+/*               MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                      */
+/*               GNU General Public License for more details.                                       */
+/*                                                                                                  */
+/*               You should have received a copy of the GNU General Public License                  */
+/*               along with this program.  If not, see <http://www.gnu.org/licenses/>.              */
+/****************************************************************************************************/
+#ifndef OUTPUTBUFFER_H_
+#define OUTPUTBUFFER_H_
+
+#include <cerrno>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include <unistd.h>
+#include "myString.h"
+
+/*
+ * Description:
+ *   std::cout << value << std::endl formats through the stream's locale facets and flushes on
+ *   every line, which is most of the time spent when millions of records are written.
+ *   outputBuffer collects the text in one buffer it keeps reusing and hands it to the sink only
+ *   when the buffer is full, on flush () and when it is destroyed:
+ *
+ *     outputBuffer out (std::cout);              // or a file descriptor, see below
+ *     for (int v : values)
+ *       out << v << '\n';                        // no flush per line
+ *     out.flush ();                              // or let the destructor do it
+ *
+ *   - Integers are formatted two digits at a time from a table, floating point numbers in fixed
+ *     notation with up to precision () decimals and 15 significant digits (trailing zeros
+ *     dropped); values from 1e15 up, inf and nan go through snprintf %g. Apart from that fallback
+ *     no locale is consulted, the decimal point is always '.'.
+ *   - The sink is a std::ostream (one write per buffer, so output stays in order with other
+ *     writes to the same stream) or a file descriptor written with write (2).
+ *   - outputBuffer (fd, capacity, true) is asynchronous: a full buffer is handed to a writer
+ *     thread and filling goes on in a spare one, so formatting and the write system calls
+ *     overlap. At most s_asyncBuffers buffers are in flight, a faster producer waits for the
+ *     writer.
+ *   - flush () returns once everything written so far has reached the sink. Write errors are
+ *     thrown as std::system_error, from the writer thread at the next flush (). The destructor
+ *     flushes and drops errors.
+ */
+
+class outputBuffer
+{
+public:
+  static const size_t s_defaultCapacity = 64 << 10;
+  static const size_t s_asyncBuffers = 4;
+  static const size_t s_maxNumber = 32; // longest formatted number
+
+  explicit
+  outputBuffer (std::ostream& os, size_t capacity = s_defaultCapacity) :
+      m_stream (&os), m_fd (-1), m_capacity (capacity > s_maxNumber ? capacity : s_maxNumber), m_precision (6)
+  {
+    m_current = newChunk ();
+  }
+  explicit
+  outputBuffer (int fd, size_t capacity = s_defaultCapacity, bool async = false) :
+      m_stream (nullptr), m_fd (fd), m_capacity (capacity > s_maxNumber ? capacity : s_maxNumber), m_precision (6)
+  {
+    m_current = newChunk ();
+    if (async)
+      {
+	m_writer.reset (new writer ());
+	m_writer->m_thread = std::thread (&outputBuffer::writerLoop, this);
+      }
+  }
+  ~outputBuffer ()
+  {
+    try
+      {
+	flush ();
+      }
+    catch (...)
+      {
+      }
+    if (m_writer)
+      {
+	  {
+	    std::lock_guard<std::mutex> lock (m_writer->m_mutex);
+	    m_writer->m_stop = true;
+	  }
+	m_writer->m_wake.notify_all ();
+	m_writer->m_thread.join ();
+      }
+  }
+  outputBuffer (const outputBuffer&) = delete;
+  outputBuffer&
+  operator = (const outputBuffer&) = delete;
+
+  outputBuffer&
+  write (const char* data, size_t size)
+  {
+    while (size)
+      {
+	size_t n = std::min (size, m_capacity - m_current.size);
+	memcpy (m_current.data.get () + m_current.size, data, n);
+	m_current.size += n;
+	data += n;
+	size -= n;
+	if (m_current.size == m_capacity)
+	  handOver ();
+      }
+    return *this;
+  }
+
+  outputBuffer&
+  operator << (char c)
+  {
+    if (m_current.size == m_capacity)
+      handOver ();
+    m_current.data[m_current.size++] = c;
+    return *this;
+  }
+  outputBuffer&
+  operator << (const char* s)
+  {
+    return write (s, strlen (s));
+  }
+  outputBuffer&
+  operator << (const std::string& s)
+  {
+    return write (s.data (), s.size ());
+  }
+  template<class ALLOC>
+    outputBuffer&
+    operator << (const basicMyString<ALLOC>& s)
+    {
+      return write (s.m_data, s.length ());
+    }
+
+  ///
+  /// Integers, bool as 0 / 1. char types are written as characters, like std::ostream does.
+  ///
+  template<class T>
+    typename std::enable_if<std::is_integral<T>::value && (sizeof(T) > 1), outputBuffer&>::type
+    operator << (T value)
+    {
+      char* end = room (s_maxNumber) + s_maxNumber;
+      char* begin;
+      if (std::is_signed<T>::value && value < 0)
+	{
+	  begin = formatUnsigned (0 - uint64_t (value), end);
+	  *--begin = '-';
+	}
+      else
+	begin = formatUnsigned (uint64_t (value), end);
+      // formatted right aligned in the reserved room, move it to where the text continues
+      size_t n = end - begin;
+      memmove (m_current.data.get () + m_current.size, begin, n);
+      m_current.size += n;
+      return *this;
+    }
+  outputBuffer&
+  operator << (bool value)
+  {
+    return *this << char ('0' + value);
+  }
+  outputBuffer&
+  operator << (signed char c)
+  {
+    return *this << char (c);
+  }
+  outputBuffer&
+  operator << (unsigned char c)
+  {
+    return *this << char (c);
+  }
+
+  outputBuffer&
+  operator << (double value)
+  {
+    double magnitude = std::fabs (value);
+    if (!(magnitude < 1e15)) // also inf and nan
+      {
+	char* at = room (s_maxNumber);
+	m_current.size += snprintf (at, s_maxNumber, "%.*g", m_precision + 1, value);
+	return *this;
+      }
+    // at most 15 significant digits, all a double holds exactly, big numbers get fewer decimals
+    int decimals = m_precision;
+    while (decimals && magnitude * power10 (decimals) >= 1e15)
+      --decimals;
+    double scale = power10 (decimals);
+    uint64_t scaled = uint64_t (magnitude * scale + 0.5);
+    uint64_t whole = scaled / uint64_t (scale);
+    uint64_t fraction = scaled % uint64_t (scale);
+    if (std::signbit (value) && scaled)
+      *this << '-';
+    *this << whole;
+    if (fraction)
+      {
+	char digits[s_maxNumber];
+	char* end = digits + decimals;
+	char* begin = formatUnsigned (fraction, end);
+	while (begin > digits)
+	  *--begin = '0';
+	while (end[-1] == '0')
+	  --end;
+	*this << '.';
+	write (digits, end - digits);
+      }
+    return *this;
+  }
+  outputBuffer&
+  operator << (float value)
+  {
+    return *this << double (value);
+  }
+
+  ///
+  /// Decimals written for floating point numbers, at most 15
+  ///
+  outputBuffer&
+  precision (int decimals)
+  {
+    m_precision = std::max (0, std::min (decimals, 15));
+    return *this;
+  }
+
+  ///
+  /// Writes everything so far to the sink and waits until it is written
+  ///
+  outputBuffer&
+  flush ()
+  {
+    if (m_current.size)
+      handOver ();
+    if (m_writer)
+      {
+	std::unique_lock<std::mutex> lock (m_writer->m_mutex);
+	m_writer->m_idle.wait (lock, [this]()
+	  { return m_writer->m_full.empty () && !m_writer->m_busy;});
+	if (m_writer->m_error)
+	  {
+	    std::exception_ptr error = m_writer->m_error;
+	    m_writer->m_error = nullptr;
+	    std::rethrow_exception (error);
+	  }
+      }
+    else if (m_stream)
+      m_stream->flush ();
+    return *this;
+  }
+
+private:
+  struct chunk
+  {
+    std::unique_ptr<char[]> data;
+    size_t size;
+  };
+  struct writer
+  {
+    std::mutex m_mutex;
+    std::condition_variable m_wake; // a buffer to write or stop
+    std::condition_variable m_idle; // a buffer got free, or all is written
+    std::deque<chunk> m_full;
+    std::vector<chunk> m_spare;
+    size_t m_chunks;                // allocated, including the one being filled
+    bool m_busy;
+    bool m_stop;
+    std::exception_ptr m_error;
+    std::thread m_thread;
+
+    writer () :
+	m_chunks (1), m_busy (false), m_stop (false)
+    {
+    }
+  };
+
+  std::ostream* m_stream;
+  int m_fd;
+  size_t m_capacity;
+  int m_precision;
+  chunk m_current;
+  std::unique_ptr<writer> m_writer;
+
+  static double
+  power10 (int exponent)
+  {
+    static const double powers[16] =
+      { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15 };
+    return powers[exponent];
+  }
+
+  chunk
+  newChunk () const
+  {
+    chunk c =
+      { std::unique_ptr<char[]> (new char[m_capacity]), 0 };
+    return c;
+  }
+
+  ///
+  /// Pointer to n free bytes at the end of the buffer
+  ///
+  char*
+  room (size_t n)
+  {
+    if (m_capacity - m_current.size < n)
+      handOver ();
+    return m_current.data.get () + m_current.size;
+  }
+
+  static char*
+  formatUnsigned (uint64_t value, char* end)
+  {
+    static const char pairs[] = "00010203040506070809101112131415161718192021222324252627282930313233"
+	"3435363738394041424344454647484950515253545556575859606162636465666768697071727374757677"
+	"78798081828384858687888990919293949596979899";
+    while (value >= 100)
+      {
+	const char* pair = pairs + (value % 100) * 2;
+	value /= 100;
+	*--end = pair[1];
+	*--end = pair[0];
+      }
+    if (value >= 10)
+      {
+	*--end = pairs[value * 2 + 1];
+	*--end = pairs[value * 2];
+      }
+    else
+      *--end = char ('0' + value);
+    return end;
+  }
+
+  void
+  writeOut (const char* data, size_t size)
+  {
+    if (m_stream)
+      {
+	if (!m_stream->write (data, size))
+	  throw std::system_error (EIO, std::generic_category (), "outputBuffer: stream write");
+	return;
+      }
+    while (size)
+      {
+	ssize_t n = ::write (m_fd, data, size);
+	if (n < 0)
+	  {
+	    if (errno == EINTR)
+	      continue;
+	    throw std::system_error (errno, std::generic_category (), "outputBuffer: write");
+	  }
+	data += n;
+	size -= n;
+      }
+  }
+
+  ///
+  /// Passes the filled buffer on: written right away, or queued for the writer thread while
+  /// filling continues in a spare buffer
+  ///
+  void
+  handOver ()
+  {
+    if (!m_writer)
+      {
+	size_t size = m_current.size;
+	m_current.size = 0;
+	writeOut (m_current.data.get (), size);
+	return;
+      }
+    chunk next;
+      {
+	std::unique_lock<std::mutex> lock (m_writer->m_mutex);
+	if (m_writer->m_spare.empty () && m_writer->m_chunks == s_asyncBuffers)
+	  m_writer->m_idle.wait (lock, [this]()
+	    { return !m_writer->m_spare.empty ();});
+	m_writer->m_full.push_back (std::move (m_current));
+	if (!m_writer->m_spare.empty ())
+	  {
+	    next = std::move (m_writer->m_spare.back ());
+	    m_writer->m_spare.pop_back ();
+	  }
+	else
+	  m_writer->m_chunks++;
+      }
+    m_writer->m_wake.notify_one ();
+    m_current = next.data ? std::move (next) : newChunk ();
+    m_current.size = 0;
+  }
+
+  void
+  writerLoop ()
+  {
+    writer& w = *m_writer;
+    std::unique_lock<std::mutex> lock (w.m_mutex);
+    for (;;)
+      {
+	w.m_wake.wait (lock, [&w]()
+	  { return w.m_stop || !w.m_full.empty ();});
+	if (w.m_full.empty ())
+	  return; // stopping, everything is written
+	chunk c = std::move (w.m_full.front ());
+	w.m_full.pop_front ();
+	w.m_busy = true;
+	lock.unlock ();
+	try
+	  {
+	    writeOut (c.data.get (), c.size);
+	  }
+	catch (...)
+	  {
+	    lock.lock ();
+	    if (!w.m_error)
+	      w.m_error = std::current_exception ();
+	    lock.unlock ();
+	  }
+	lock.lock ();
+	w.m_busy = false;
+	w.m_spare.push_back (std::move (c));
+	w.m_idle.notify_all ();
+      }
+  }
+};
+
+#endif /* OUTPUTBUFFER_H_ */
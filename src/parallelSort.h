@@ -0,0 +1,335 @@
+/****************************************************************************************************/
+/*                                                                                                  */
+/* @module        : Cpp 11 features examples                                                        */
+/* @file          : parallelSort.h                                                                  */
+/* @brief         : LSD radix sort for integer keys and parallel merge sort                         */
+/* @input         :                                                                                 */
+/* @outpu         :                                                                                 */
+/* @date          : 16-October-2026                                                                 */
+/* @author        : Pratik Patil                                                                    */
+/* License        :                                                                                 */
+/*               Copyright (C) 2017  Pratik Patil                                                   */
+/*                                                                                                  */
+/*               This program is free software: you can redistribute it and/or modify               */
+/*               it under the terms of the GNU General Public License Version 3 as published by     */
+/*               the Free Software Foundation.                                                      */
+/*                                                                                                  */
+/*               This program is distributed in the hope that it will be useful,                    */
+/*               but WITHOUT ANY WARRANTY; without even the implied warranty of                     */
+/*               MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                      */
+/*               GNU General Public License for more details.                                       */
+/*                                                                                                  */
+/*               You should have received a copy of the GNU General Public License                  */
+/*               along with this program.  If not, see <http://www.gnu.org/licenses/>.              */
+/****************************************************************************************************/
+#ifndef PARALLELSORT_H_
+#define PARALLELSORT_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "threadPool.h"
+
+/*
+ * Description:
+ *   The lambda demos scan int arrays linearly; sorted once, the same data is queried with
+ *   sortedLowerBound / gallopUpperBound (search.h). std::sort is a single threaded comparison sort,
+ *   this module has two faster ways to get there:
+ *
+ *   - radixSort (first, last [, key]) sorts by an integer key of 8 to 64 bits, signed or unsigned.
+ *     It is a least significant digit radix sort: one pass per byte of the key, each pass counts
+ *     the elements per byte value and moves them to a buffer in that order, so the cost is linear
+ *     in n and no comparison is made. Bytes which are equal in all keys (the high bytes of small
+ *     numbers) are skipped. key (element) picks the key out of records, e.g. key value pairs:
+ *
+ *       radixSort (vec.begin (), vec.end ());
+ *       radixSort (pairs.begin (), pairs.end (), [](const std::pair<uint64_t, int>& p)
+ *         { return p.first;});
+ *
+ *   - parallelMergeSort (first, last, comp) takes the same comparator lambdas as std::sort. The
+ *     range is cut into pieces sorted in parallel, then neighbouring runs are merged round by
+ *     round; every merge is split again into independent pieces (by binary search of the split
+ *     points), so all threads keep working until the last round.
+ *
+ *   Both are stable, take an optional threadPool like the algorithms of threadPool.h, and use a
+ *   buffer of n elements (elements must be default constructible and movable). Small ranges go to
+ *   std::stable_sort.
+ */
+
+///
+/// Where radixSort and parallelMergeSort stop splitting
+///
+struct sortLimits
+{
+  static const size_t s_sortSmall = 256;       // below: std::stable_sort
+  static const size_t s_sortChunk = 1 << 16;    // least elements per parallel piece
+};
+
+struct identityKey
+{
+  template<class T>
+    const T&
+    operator () (const T& value) const
+    {
+      return value;
+    }
+};
+
+///
+/// Key of value as an unsigned integer of the same width which sorts the same way: signed keys
+/// get their sign bit flipped, so negative numbers come first.
+///
+template<class K>
+  typename std::make_unsigned<K>::type
+  radixBits (K key)
+  {
+    typedef typename std::make_unsigned<K>::type U;
+    static const U flip = std::is_signed<K>::value ? U (1) << (sizeof(K) * 8 - 1) : 0;
+    return U (key) ^ flip;
+  }
+
+template<class SRC, class KEY>
+  void
+  radixCount (SRC src, size_t begin, size_t end, KEY& key, size_t shift, size_t* count)
+  {
+    std::fill (count, count + 256, 0);
+    for (size_t i = begin; i < end; ++i)
+      count[(radixBits (key (src[i])) >> shift) & 0xFF]++;
+  }
+
+///
+/// Moves src[begin, end) to dst, each element to the next free index of its byte value
+///
+template<class SRC, class DST, class KEY>
+  void
+  radixScatter (SRC src, DST dst, size_t begin, size_t end, KEY& key, size_t shift, size_t* offset)
+  {
+    for (size_t i = begin; i < end; ++i)
+      dst[offset[(radixBits (key (src[i])) >> shift) & 0xFF]++] = std::move (src[i]);
+  }
+
+template<class ITER, class KEY>
+  void
+  radixSort (ITER first, ITER last, KEY key, threadPool& pool = threadPool::global ())
+  {
+    typedef typename std::iterator_traits<ITER>::value_type T;
+    typedef typename std::decay<decltype (key (*first))>::type K;
+    static_assert (std::is_integral<K>::value, "radixSort needs an integer key");
+    static const size_t s_digits = sizeof(K);
+    typedef std::vector<size_t> histogram; // 256 counters per digit
+
+    size_t n = last - first;
+    if (n < sortLimits::s_sortSmall)
+      {
+	std::stable_sort (first, last, [&key](const T& a, const T& b)
+	  { return radixBits (key (a)) < radixBits (key (b));});
+	return;
+      }
+    size_t chunks = std::max<size_t> (1, std::min<size_t> (pool.size () * 4,
+							     n / sortLimits::s_sortChunk));
+    size_t chunkSize = (n + chunks - 1) / chunks;
+    chunks = (n + chunkSize - 1) / chunkSize;
+
+    // all digits are counted in one read, the totals don't change from pass to pass
+    std::vector<histogram> counts (chunks, histogram (256 * s_digits));
+    pool.forRange (0, chunks, 1, [&](size_t b, size_t e)
+      {
+	for (size_t c = b; c < e; ++c)
+	  {
+	    size_t* count = counts[c].data ();
+	    for (ITER p = first + c * chunkSize, end = first + std::min (n, (c + 1) * chunkSize);
+		p != end; ++p)
+	      {
+		auto bits = radixBits (key (*p));
+		for (size_t d = 0; d < s_digits; ++d)
+		  count[d * 256 + ((bits >> (d * 8)) & 0xFF)]++;
+	      }
+	  }
+      });
+    histogram total (256 * s_digits, 0);
+    for (const histogram& count : counts)
+      for (size_t i = 0; i < total.size (); ++i)
+	total[i] += count[i];
+
+    std::vector<T> buffer (n);
+    bool inBuffer = false, moved = false;
+    std::vector<histogram> offsets (chunks, histogram (256));
+    for (size_t d = 0; d < s_digits; ++d)
+      {
+	const size_t* digitTotal = &total[d * 256];
+	if (std::find (digitTotal, digitTotal + 256, n) != digitTotal + 256)
+	  continue; // every key has the same byte here, the pass would not move anything
+	size_t shift = d * 8;
+
+	// until the first pass moves anything the chunks hold what was counted above, after it
+	// they hold other elements and this digit is counted again per chunk
+	if (chunks > 1)
+	  pool.forRange (0, chunks, 1, [&](size_t b, size_t e)
+	    {
+	      for (size_t c = b; c < e; ++c)
+		{
+		  size_t* count = offsets[c].data ();
+		  if (!moved)
+		    {
+		      std::copy (&counts[c][d * 256], &counts[c][d * 256] + 256, count);
+		      continue;
+		    }
+		  size_t end = std::min (n, (c + 1) * chunkSize);
+		  if (inBuffer)
+		    radixCount (buffer.begin (), c * chunkSize, end, key, shift, count);
+		  else
+		    radixCount (first, c * chunkSize, end, key, shift, count);
+		}
+	    });
+	// offset of chunk c in bucket v: all smaller buckets, then bucket v of the chunks before c
+	size_t running = 0;
+	for (size_t v = 0; v < 256; ++v)
+	  {
+	    if (chunks == 1)
+	      {
+		offsets[0][v] = running;
+		running += digitTotal[v];
+		continue;
+	      }
+	    for (size_t c = 0; c < chunks; ++c)
+	      {
+		size_t count = offsets[c][v];
+		offsets[c][v] = running;
+		running += count;
+	      }
+	  }
+	pool.forRange (0, chunks, 1, [&](size_t b, size_t e)
+	  {
+	    for (size_t c = b; c < e; ++c)
+	      {
+		size_t end = std::min (n, (c + 1) * chunkSize);
+		if (inBuffer)
+		  radixScatter (buffer.begin (), first, c * chunkSize, end, key, shift,
+				offsets[c].data ());
+		else
+		  radixScatter (first, buffer.begin (), c * chunkSize, end, key, shift,
+				offsets[c].data ());
+	      }
+	  });
+	inBuffer = !inBuffer;
+	moved = true;
+      }
+    if (inBuffer)
+      std::move (buffer.begin (), buffer.end (), first);
+  }
+
+template<class ITER>
+  void
+  radixSort (ITER first, ITER last, threadPool& pool = threadPool::global ())
+  {
+    radixSort (first, last, identityKey (), pool);
+  }
+
+///
+/// Stable merge of the sorted runs [a, aEnd) and [b, bEnd) into out, cut into pieces of about
+/// piece elements which are merged independently. Appends one (a, aEnd, b, bEnd, out) job per piece.
+///
+template<class ITER, class OUT, class COMP, class JOBS>
+  void
+  splitMerge (ITER a, ITER aEnd, ITER b, ITER bEnd, OUT out, COMP& comp, size_t piece, JOBS& jobs)
+  {
+    size_t na = aEnd - a;
+    size_t pieces = std::max<size_t> (1, (na + (bEnd - b)) / piece);
+    ITER aFrom = a, bFrom = b;
+    for (size_t p = 1; p <= pieces; ++p)
+      {
+	ITER aTo = p == pieces ? aEnd : a + na * p / pieces;
+	// b elements equal to *aTo stay behind the a ones, which keeps the merge stable
+	ITER bTo = p == pieces ? bEnd : std::lower_bound (bFrom, bEnd, *aTo, comp);
+	jobs.push_back (std::make_tuple (aFrom, aTo, bFrom, bTo, out + ((aFrom - a) + (bFrom - b))));
+	aFrom = aTo;
+	bFrom = bTo;
+      }
+  }
+
+///
+/// Runs the merges splitMerge queued, in parallel
+///
+template<class JOBS, class COMP>
+  void
+  mergePieces (const JOBS& jobs, COMP& comp, threadPool& pool)
+  {
+    pool.forRange (0, jobs.size (), 1, [&](size_t b, size_t e)
+      {
+	for (size_t j = b; j < e; ++j)
+	  std::merge (std::make_move_iterator (std::get<0> (jobs[j])),
+		      std::make_move_iterator (std::get<1> (jobs[j])),
+		      std::make_move_iterator (std::get<2> (jobs[j])),
+		      std::make_move_iterator (std::get<3> (jobs[j])), std::get<4> (jobs[j]), comp);
+      });
+  }
+
+template<class ITER, class COMP>
+  void
+  parallelMergeSort (ITER first, ITER last, COMP comp, threadPool& pool = threadPool::global ())
+  {
+    typedef typename std::iterator_traits<ITER>::value_type T;
+    size_t n = last - first;
+    const size_t chunk = sortLimits::s_sortChunk;
+    size_t runs = std::max<size_t> (1, std::min<size_t> (pool.size () * 4, n / chunk));
+    if (n < sortLimits::s_sortSmall || runs == 1)
+      {
+	std::stable_sort (first, last, comp);
+	return;
+      }
+    std::vector<size_t> bounds;
+    for (size_t r = 0; r <= runs; ++r)
+      bounds.push_back (n * r / runs);
+    pool.forRange (0, runs, 1, [&](size_t b, size_t e)
+      {
+	for (size_t r = b; r < e; ++r)
+	  std::stable_sort (first + bounds[r], first + bounds[r + 1], comp);
+      });
+
+    std::vector<T> buffer (n);
+    typedef typename std::vector<T>::iterator bufferIter;
+    bool inBuffer = false;
+    size_t piece = std::max (chunk, n / (pool.size () * 4));
+    while (bounds.size () > 2)
+      {
+	std::vector<size_t> merged;
+	std::vector<std::tuple<ITER, ITER, ITER, ITER, bufferIter> > toBuffer;
+	std::vector<std::tuple<bufferIter, bufferIter, bufferIter, bufferIter, ITER> > fromBuffer;
+	for (size_t r = 0; r + 1 < bounds.size (); r += 2)
+	  {
+	    merged.push_back (bounds[r]);
+	    size_t mid = bounds[r + 1], end = r + 2 < bounds.size () ? bounds[r + 2] : mid;
+	    if (inBuffer)
+	      splitMerge (buffer.begin () + bounds[r], buffer.begin () + mid, buffer.begin () + mid,
+			  buffer.begin () + end, first + bounds[r], comp, piece, fromBuffer);
+	    else
+	      splitMerge (first + bounds[r], first + mid, first + mid, first + end,
+			  buffer.begin () + bounds[r], comp, piece, toBuffer);
+	  }
+	merged.push_back (n);
+	if (inBuffer)
+	  mergePieces (fromBuffer, comp, pool);
+	else
+	  mergePieces (toBuffer, comp, pool);
+	bounds.swap (merged);
+	inBuffer = !inBuffer;
+      }
+    if (inBuffer)
+      std::move (buffer.begin (), buffer.end (), first);
+  }
+
+template<class ITER>
+  void
+  parallelMergeSort (ITER first, ITER last, threadPool& pool = threadPool::global ())
+  {
+    parallelMergeSort (first, last, std::less<typename std::iterator_traits<ITER>::value_type> (),
+		       pool);
+  }
+
+#endif /* PARALLELSORT_H_ */
@@ -0,0 +1,334 @@
+/****************************************************************************************************/
+/*                                                                                                  */
+/* @module        : Cpp 11 features examples                                                        */
+/* @file          : ringQueue.h                                                                     */
+/* @brief         : Bounded lock free multi producer multi consumer queue                           */
+/* @input         :                                                                                 */
+/* @outpu         :                                                                                 */
+/* @date          : 16-October-2026                                                                 */
+/* @author        : Pratik Patil                                                                    */
+/* License        :                                                                                 */
+/*               Copyright (C) 2017  Pratik Patil                                                   */
+/*                                                                                                  */
+/*               This program is free software: you can redistribute it and/or modify               */
+/*               it under the terms of the GNU General Public License Version 3 as published by     */
+/*               the Free Software Foundation.                                                      */
+/*                                                                                                  */
+/*               This program is distributed in the hope that it will be useful,                    */
+/*               but WITHOUT ANY WARRANTY; without even the implied warranty of                     */
+/*               MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                      */
+/*               GNU General Public License for more details.                                       */
+/*                                                                                                  */
+/*               You should have received a copy of the GNU General Public License                  */
+/*               along with this program.  If not, see <http://www.gnu.org/licenses/>.              */
+/****************************************************************************************************/
+#ifndef RINGQUEUE_H_
+#define RINGQUEUE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+/*
+ * Description:
+ *   Handing myStrings from one thread to another through a std::queue needs a mutex around every
+ *   push and pop. ringQueue<T> is a fixed size ring any number of threads push into and pop from
+ *   without a lock; elements are moved in and out, so move only types work and a myString's
+ *   buffer travels between threads without being copied:
+ *
+ *     ringQueue<myString> lines (1024);
+ *     lines.push (std::move (line));              // producer, waits while the ring is full
+ *     myString next;
+ *     if (lines.tryPop (next))                    // consumer, false when the ring is empty
+ *       ...
+ *
+ *   - Every slot carries a sequence number telling which lap of the ring it is ready for. A
+ *     producer claims position p with one compare and swap on the enqueue counter once slot
+ *     p % capacity says it is free for lap p, constructs the element, then publishes it by bumping
+ *     the sequence. Consumers do the same on the dequeue counter. Producers and consumers only
+ *     meet on the slot they hand over.
+ *   - Slots and both counters sit on their own cache line (s_cacheLine), so threads working on
+ *     neighbouring slots do not invalidate each other's lines.
+ *   - tryPushBatch / tryPopBatch claim as many consecutive ready slots as they can, up to count,
+ *     with a single compare and swap, which divides the counter traffic by the batch size.
+ *   - try* return false (or 0 elements) immediately; push / pop spin briefly and then yield until
+ *     they succeed. A failed tryPush leaves its argument untouched.
+ *   - Capacity is rounded up to a power of two. Elements left in the ring are destroyed with it.
+ *   - T must move without throwing (myString and std::string do). The output iterator of
+ *     tryPopBatch must not throw either, e.g. pop into a vector sized beforehand.
+ */
+
+template<class T>
+  class ringQueue
+  {
+    // a claimed slot must be filled or emptied, a throwing move would leave it claimed forever
+    static_assert (std::is_nothrow_move_constructible<T>::value
+		   && std::is_nothrow_move_assignable<T>::value,
+		   "ringQueue needs a noexcept move constructor and move assignment");
+
+  public:
+    static const size_t s_cacheLine = 64;
+
+    explicit
+    ringQueue (size_t capacity) :
+	m_mask (roundUp (capacity) - 1), m_raw (new char[(m_mask + 2) * sizeof(slot)]), m_slots (
+	    align (m_raw.get ()))
+    {
+      for (size_t i = 0; i <= m_mask; ++i)
+	new (&m_slots[i]) slot (i);
+      m_enqueue.value.store (0, std::memory_order_relaxed);
+      m_dequeue.value.store (0, std::memory_order_relaxed);
+    }
+    ~ringQueue ()
+    {
+      size_t last = m_enqueue.value.load (std::memory_order_relaxed);
+      for (size_t p = m_dequeue.value.load (std::memory_order_relaxed); p != last; ++p)
+	at (p).object ()->~T ();
+      for (size_t i = 0; i <= m_mask; ++i)
+	m_slots[i].~slot ();
+    }
+    ringQueue (const ringQueue&) = delete;
+    ringQueue&
+    operator = (const ringQueue&) = delete;
+
+    bool
+    tryPush (T&& value)
+    {
+      size_t position;
+      slot* s = claim (m_enqueue.value, 0, position);
+      if (!s)
+	return false;
+      new (s->object ()) T (std::move (value));
+      s->sequence.store (position + 1, std::memory_order_release);
+      return true;
+    }
+    bool
+    tryPush (const T& value)
+    {
+      T copy (value);
+      return tryPush (std::move (copy));
+    }
+
+    ///
+    /// Builds the element before claiming a slot, so a throwing constructor leaves the ring intact
+    ///
+    template<class ... ARGS>
+      bool
+      tryEmplace (ARGS&&... args)
+      {
+	return tryPush (T (std::forward<ARGS> (args)...));
+      }
+    void
+    push (T&& value)
+    {
+      for (unsigned spins = 0; !tryPush (std::move (value)); ++spins)
+	backoff (spins);
+    }
+    void
+    push (const T& value)
+    {
+      T copy (value);
+      push (std::move (copy));
+    }
+
+    bool
+    tryPop (T& value)
+    {
+      size_t position;
+      slot* s = claim (m_dequeue.value, 1, position);
+      if (!s)
+	return false;
+      take (s, position, value);
+      return true;
+    }
+    void
+    pop (T& value)
+    {
+      for (unsigned spins = 0; !tryPop (value); ++spins)
+	backoff (spins);
+    }
+
+    ///
+    /// Moves up to count elements from first on into the ring, returns how many went in
+    ///
+    template<class ITER>
+      size_t
+      tryPushBatch (ITER first, size_t count)
+      {
+	size_t position;
+	size_t claimed = claimBatch (m_enqueue.value, 0, count, position);
+	for (size_t i = 0; i < claimed; ++i, ++first)
+	  {
+	    slot& s = at (position + i);
+	    new (s.object ()) T (std::move (*first));
+	    s.sequence.store (position + i + 1, std::memory_order_release);
+	  }
+	return claimed;
+      }
+
+    ///
+    /// Moves up to count elements out of the ring to out, returns how many came out
+    ///
+    template<class OUT>
+      size_t
+      tryPopBatch (OUT out, size_t count)
+      {
+	size_t position;
+	size_t claimed = claimBatch (m_dequeue.value, 1, count, position);
+	for (size_t i = 0; i < claimed; ++i, ++out)
+	  take (&at (position + i), position + i, *out);
+	return claimed;
+      }
+
+    size_t
+    capacity () const
+    {
+      return m_mask + 1;
+    }
+
+    ///
+    /// Elements in the ring, only exact while no other thread pushes or pops
+    ///
+    size_t
+    sizeApprox () const
+    {
+      size_t dequeued = m_dequeue.value.load (std::memory_order_acquire);
+      size_t enqueued = m_enqueue.value.load (std::memory_order_acquire);
+      return enqueued > dequeued ? enqueued - dequeued : 0;
+    }
+
+  private:
+    struct alignas(s_cacheLine) slot
+    {
+      std::atomic<size_t> sequence;
+      typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+
+      explicit
+      slot (size_t lap) :
+	  sequence (lap)
+      {
+      }
+      T*
+      object ()
+      {
+	return reinterpret_cast<T*> (&storage);
+      }
+    };
+
+    struct alignas(s_cacheLine) counter
+    {
+      std::atomic<size_t> value;
+    };
+
+    size_t m_mask;
+    std::unique_ptr<char[]> m_raw;
+    slot* m_slots;
+    counter m_enqueue;
+    counter m_dequeue;
+
+    static size_t
+    roundUp (size_t capacity)
+    {
+      if (capacity < 2 || capacity > (SIZE_MAX >> 2))
+	throw std::length_error ("ringQueue: capacity must be at least 2");
+      size_t size = 2;
+      while (size < capacity)
+	size <<= 1;
+      return size;
+    }
+
+    ///
+    /// new char[] is only aligned for fundamental types, the spare slot allocated makes room to
+    /// move the ring to a cache line boundary
+    ///
+    static slot*
+    align (char* raw)
+    {
+      uintptr_t address = reinterpret_cast<uintptr_t> (raw);
+      return reinterpret_cast<slot*> ((address + alignof(slot) - 1) & ~uintptr_t (alignof(slot) - 1));
+    }
+
+    slot&
+    at (size_t position)
+    {
+      return m_slots[position & m_mask];
+    }
+
+    ///
+    /// Claims the next position of counter. A slot is ready for a producer when its sequence equals
+    /// the position (ready == 0) and for a consumer when it equals position + 1 (ready == 1).
+    ///
+    slot*
+    claim (std::atomic<size_t>& counter, size_t ready, size_t& position)
+    {
+      position = counter.load (std::memory_order_relaxed);
+      for (;;)
+	{
+	  slot& s = at (position);
+	  size_t sequence = s.sequence.load (std::memory_order_acquire);
+	  intptr_t lag = intptr_t (sequence) - intptr_t (position + ready);
+	  if (lag == 0)
+	    {
+	      if (counter.compare_exchange_weak (position, position + 1, std::memory_order_relaxed))
+		return &s;
+	    }
+	  else if (lag < 0)
+	    return nullptr; // full for producers, empty for consumers
+	  else
+	    position = counter.load (std::memory_order_relaxed);
+	}
+    }
+
+    size_t
+    claimBatch (std::atomic<size_t>& counter, size_t ready, size_t count, size_t& position)
+    {
+      if (count == 0)
+	return 0;
+      position = counter.load (std::memory_order_relaxed);
+      for (;;)
+	{
+	  size_t n = 0;
+	  intptr_t lag = 0;
+	  while (n < count && n <= m_mask)
+	    {
+	      lag = intptr_t (at (position + n).sequence.load (std::memory_order_acquire))
+		  - intptr_t (position + n + ready);
+	      if (lag != 0)
+		break;
+	      ++n;
+	    }
+	  if (n == 0 && lag < 0)
+	    return 0;
+	  // slots claimed by nobody yet can't change, so n stays valid as long as counter does
+	  if (n && counter.compare_exchange_weak (position, position + n, std::memory_order_relaxed))
+	    return n;
+	  if (!n)
+	    position = counter.load (std::memory_order_relaxed);
+	}
+    }
+
+    template<class V>
+      void
+      take (slot* s, size_t position, V& value)
+      {
+	T* object = s->object ();
+	value = std::move (*object);
+	object->~T ();
+	s->sequence.store (position + m_mask + 1, std::memory_order_release);
+      }
+
+    static void
+    backoff (unsigned spins)
+    {
+      if (spins >= 64)
+	std::this_thread::yield ();
+    }
+  };
+
+#endif /* RINGQUEUE_H_ */
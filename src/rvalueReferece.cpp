@@ -24,6 +24,13 @@
 /****************************************************************************************************/
 #include <iostream>
 #include <cstring>
+#include <thread>
+// This sample is about seeing copies and moves happen, so always count them
+#ifndef MYSTRING_STATS
+#define MYSTRING_STATS
+#endif
+#include "myString.h"
+#include "ringQueue.h"
 /*
  * Description:
  *   Reference types in C++03 can only bind to lvalues. C++11 introduces a new category of
@@ -36,64 +43,21 @@
  *   and unnecessary, a move operation can be used instead.
  */
 
-/// Lets see how this move semantics can improve performance of string swapping
-class myString
-{
-
-public:
-  char* m_data;
-  size_t m_size;
-  myString ()
-  {
-    m_size = 0;
-    m_data = nullptr;
-  }
-  myString (const char* ptr)
-  {
-    std::cout << "Using char* to \"" << ptr << "\"" << std::endl;
-    m_size = strlen (ptr) + 1;
-    m_data = new char[m_size];
-    memcpy (m_data, ptr, m_size);
-  }
-  ~myString ()
-  {
-    delete[] m_data;
-  }
-  // Simple copy constructor
-  myString (const myString& str)
-  {
-    std::cout << "Using copy constructor" << std::endl;
-    m_size = str.m_size;
-    m_data = new char[m_size];
-    memcpy (m_data, str.m_data, m_size);
-  }
+/// Lets see how this move semantics can improve performance of string swapping.
+/// myString (see myString.h) keeps short strings inline and reuses its buffer on assignment.
 
-  // rvalue ref
-  myString (myString&& str)
-  {
-    std::cout << "Using rvalue reference" << std::endl;
-    m_data = str.m_data;
-    m_size = str.m_size;
-    str.m_data = nullptr;
-  }
-
-//
-// This operator will do necessary memory allocations to add two strings
-//
-  myString
-  operator + (const myString& str)
-  {
-    std::cout << "Adding two strings" << std::endl;
-    myString temp;
-    temp.m_size = this->m_size + str.m_size - 1;
-    temp.m_data = new char[temp.m_size];
-    memcpy (temp.m_data, this->m_data, this->m_size);
-    // temp.m_data + this->m_size - 1 is the location of the '\0'.
-    memcpy (temp.m_data + this->m_size - 1, str.m_data, str.m_size);
+///
+/// Prints what myString did since the last call
+///
+void
+showCounters (const char* step)
+{
+  static myStringCounters last = myStringCounters ();
+  myStringCounters now = myStringStats::snapshot ();
+  std::cout << step << " -> " << (now - last) << std::endl;
+  last = now;
+}
 
-    return temp;
-  }
-};
 int
 main (int argc, char* argv[])
 {
@@ -101,11 +65,20 @@ main (int argc, char* argv[])
   char arr2[] = ".. And this is appended later";
   myString data (arr);
   myString appended (arr2);
+  showCounters ("Using char*");
 
   myString empty (std::move (myString
     { }));
-  // This will invoke rvalue ref constructor hence reducing memory allocation operation
+  showCounters ("Using rvalue reference");
+  // data + appended is only an expression holding references to both strings. It is built straight
+  // into stringFromRvalue with a single allocation, no temporary string is created and moved.
   myString stringFromRvalue (std::move (data + appended));
+  showCounters ("Adding two strings");
+
+  // Same for longer chains, total size is computed once and every piece is copied only once.
+  myString logLine = data + " | " + appended + " | " + data;
+  showCounters ("Adding five strings");
+  std::cout << logLine.m_data << std::endl;
 
   for (int i = 0; i < 10; ++i)
     {
@@ -114,5 +87,53 @@ main (int argc, char* argv[])
   std::cout << std::endl;
   std::cout << stringFromRvalue.m_data << std::endl;
 
+  // Copy assignment reuses the buffer of the target when it is big enough, and short strings
+  // like "This is data" are kept inside the object itself, so no allocation happens here.
+  myString shortString ("short");
+  shortString = data;
+  showCounters ("Using copy assignment");
+  std::cout << shortString.m_data << (shortString.isLocal () ? " (inline)" : " (heap)") << std::endl;
+
+  // Move assignment steals the heap buffer of the source.
+  shortString = std::move (stringFromRvalue);
+  showCounters ("Using move assignment");
+  std::cout << shortString.m_data << (shortString.isLocal () ? " (inline)" : " (heap)") << std::endl;
+
+  // Building a string piece by piece. The builder grows its buffer geometrically and release()
+  // moves that buffer into the result instead of copying it.
+  myStringBuilder builder;
+  for (int i = 0; i < 3; ++i)
+    builder.append (data).append (" ");
+  builder += appended;
+  myString built (builder.release ());
+  showCounters ("Using builder");
+  std::cout << built.m_data << std::endl;
+
+  // Strings of a request can come from an arena and are all freed by a single reset.
+  myStringArena requestArena;
+    {
+      myStringArena::scope requestScope (requestArena);
+      arenaString fromArena = data + " (arena)";
+      std::cout << fromArena.m_data << std::endl;
+    }
+  requestArena.reset ();
+
+  // Moving also works across threads: the producer moves its strings into a ringQueue and the
+  // consumer moves them out, each buffer changes hands without a copy and without a lock.
+  ringQueue<myString> handOver (8);
+  std::thread producer ([&handOver, &data]()
+    {
+      for (int i = 0; i < 4; ++i)
+	handOver.push (data + " from another thread");
+    });
+  myString received;
+  for (int i = 0; i < 4; ++i)
+    handOver.pop (received);
+  producer.join ();
+  showCounters ("Handing over through ringQueue");
+  std::cout << received.m_data << std::endl;
+
+  myStringStats::dump (std::cout);
+
   return 0;
 }
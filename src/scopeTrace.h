@@ -0,0 +1,352 @@
+/****************************************************************************************************/
+/*                                                                                                  */
+/* @module        : Cpp 11 features examples                                                        */
+/* @file          : scopeTrace.h                                                                    */
+/* @brief         : RAII scope tracing with hardware counters and Chrome trace export               */
+/* @input         :                                                                                 */
+/* @outpu         :                                                                                 */
+/* @date          : 16-October-2026                                                                 */
+/* @author        : Pratik Patil                                                                    */
+/* License        :                                                                                 */
+/*               Copyright (C) 2017  Pratik Patil                                                   */
+/*                                                                                                  */
+/*               This program is free software: you can redistribute it and/or modify               */
+/*               it under the terms of the GNU General Public License Version 3 as published by     */
+/*               the Free Software Foundation.                                                      */
+/*                                                                                                  */
+/*               This program is distributed in the hope that it will be useful,                    */
+/*               but WITHOUT ANY WARRANTY; without even the implied warranty of                     */
+/*               MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                      */
+/*               GNU General Public License for more details.                                       */
+/*                                                                                                  */
+/*               You should have received a copy of the GNU General Public License                  */
+/*               along with this program.  If not, see <http://www.gnu.org/licenses/>.              */
+/****************************************************************************************************/
+#ifndef SCOPETRACE_H_
+#define SCOPETRACE_H_
+
+#include <cstdint>
+#include <ostream>
+
+/*
+ * Description:
+ *   TRACE_SCOPE ("name") at the top of a block records when the block was entered and how long it
+ *   took, on the calling thread. Built without -DSCOPE_TRACE the macro expands to nothing and
+ *   none of the code below exists; with it, a scope costs two time stamp reads and one store into
+ *   a buffer of the thread.
+ *
+ *     void
+ *     stlContainersInitialization ()
+ *     {
+ *       TRACE_SCOPE ("stlContainersInitialization");
+ *       ...
+ *
+ *   - Every thread writes its events into its own ring of s_traceEvents; nothing is shared, no
+ *     lock is taken and no atomic read-modify-write is made. When the ring is full the oldest
+ *     events are overwritten.
+ *   - Time stamps are rdtsc ticks on x86 (steady_clock elsewhere), converted to microseconds when
+ *     the trace is written.
+ *   - With SCOPE_TRACE_COUNTERS=1 in the environment every thread also opens perf_event_open
+ *     counters for cycles, instructions and cache misses, and events carry their deltas. Reading
+ *     them is a system call, so a scope then costs about a microsecond. Where perf events are not
+ *     allowed (perf_event_paranoid, containers, no PMU) the counters are left out and only the
+ *     time is recorded; countersAvailable () tells which case applies.
+ *   - writeChromeTrace () writes all events as Chrome trace JSON (chrome://tracing, Perfetto).
+ *     At exit they are written to the file named by SCOPE_TRACE_FILE, if set. Events being
+ *     written while the trace is exported may be torn, export once the traced work is done.
+ */
+
+#ifdef SCOPE_TRACE
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+struct traceEvent
+{
+  const char* name;
+  uint64_t start;
+  uint64_t duration;
+  uint64_t counters[3]; // cycles, instructions, cache misses
+};
+
+class scopeTrace
+{
+public:
+  static const bool enabled = true;
+  static const size_t s_traceEvents = 1 << 14;
+  static const int s_counters = 3;
+
+  static uint64_t
+  now ()
+  {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc ();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds> (
+	std::chrono::steady_clock::now ().time_since_epoch ()).count ();
+#endif
+  }
+
+  struct buffer
+  {
+    std::atomic<uint64_t> m_head; // events written so far, the ring holds the last s_traceEvents
+    uint32_t m_thread;
+    int m_fds[s_counters];        // perf events, m_fds[0] leads the group, -1 without counters
+    bool m_counted;               // events carry counters
+    traceEvent m_events[s_traceEvents];
+
+    ///
+    /// Current counter values, false without counters
+    ///
+    bool
+    readCounters (uint64_t* values) const
+    {
+      if (m_fds[0] < 0)
+	return false;
+      uint64_t group[1 + s_counters];
+      if (read (m_fds[0], group, sizeof(group)) != sizeof(group))
+	return false;
+      memcpy (values, group + 1, sizeof(uint64_t) * s_counters);
+      return true;
+    }
+  };
+
+  ///
+  /// The calling thread's buffer, created and registered on first use
+  ///
+  static buffer&
+  threadBuffer ()
+  {
+    static thread_local owner o;
+    return *o.m_buffer;
+  }
+
+  static bool
+  countersAvailable ()
+  {
+    return threadBuffer ().m_counted;
+  }
+
+  static void
+  writeChromeTrace (std::ostream& os)
+  {
+    registry& r = theRegistry ();
+    std::lock_guard<std::mutex> lock (r.m_mutex);
+    uint64_t ticks = now () - r.m_startTicks;
+    double ns = std::chrono::duration<double, std::nano> (std::chrono::steady_clock::now ()
+	- r.m_startTime).count ();
+    double usPerTick = ticks ? ns / ticks / 1000 : 0;
+    static const char* const names[s_counters] =
+      { "cycles", "instructions", "cacheMisses" };
+
+    os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    const char* separator = "\n";
+    for (const std::unique_ptr<buffer>& b : r.m_buffers)
+      {
+	uint64_t head = b->m_head.load (std::memory_order_acquire);
+	uint64_t first = head > s_traceEvents ? head - s_traceEvents : 0;
+	for (uint64_t i = first; i < head; ++i)
+	  {
+	    const traceEvent& e = b->m_events[i & (s_traceEvents - 1)];
+	    os << separator << "{\"name\":\"";
+	    for (const char* c = e.name; *c; ++c)
+	      {
+		if (*c == '"' || *c == '\\')
+		  os << '\\';
+		os << *c;
+	      }
+	    os << "\",\"cat\":\"scope\",\"ph\":\"X\",\"pid\":" << getpid () << ",\"tid\":"
+		<< b->m_thread << ",\"ts\":" << (e.start - r.m_startTicks) * usPerTick << ",\"dur\":"
+		<< e.duration * usPerTick;
+	    if (b->m_counted)
+	      {
+		os << ",\"args\":{";
+		for (int c = 0; c < s_counters; ++c)
+		  os << (c ? "," : "") << '"' << names[c] << "\":" << e.counters[c];
+		os << "}";
+	      }
+	    os << "}";
+	    separator = ",\n";
+	  }
+      }
+    os << "\n]}\n";
+  }
+
+private:
+  struct registry
+  {
+    std::mutex m_mutex;
+    std::vector<std::unique_ptr<buffer> > m_buffers; // kept after their thread exits
+    uint64_t m_startTicks;
+    std::chrono::steady_clock::time_point m_startTime;
+    bool m_counters;
+
+    registry () :
+	m_startTicks (now ()), m_startTime (std::chrono::steady_clock::now ())
+    {
+      const char* env = getenv ("SCOPE_TRACE_COUNTERS");
+      m_counters = env && atoi (env) != 0;
+    }
+  };
+
+  // Closes the thread's counters when it exits, the events stay with the registry
+  struct owner
+  {
+    buffer* m_buffer;
+
+    owner () :
+	m_buffer (new buffer ())
+    {
+      registry& r = theRegistry ();
+      m_buffer->m_head.store (0, std::memory_order_relaxed);
+      m_buffer->m_thread = uint32_t (syscall (SYS_gettid));
+      m_buffer->m_counted = r.m_counters && openCounters (m_buffer->m_fds);
+      if (!m_buffer->m_counted)
+	std::fill (m_buffer->m_fds, m_buffer->m_fds + s_counters, -1);
+      std::lock_guard<std::mutex> lock (r.m_mutex);
+      r.m_buffers.push_back (std::unique_ptr<buffer> (m_buffer));
+    }
+    ~owner ()
+    {
+      for (int& fd : m_buffer->m_fds)
+	if (fd >= 0)
+	  {
+	    close (fd);
+	    fd = -1;
+	  }
+    }
+  };
+
+  // Writes the trace at exit when SCOPE_TRACE_FILE is set
+  struct exitWriter
+  {
+    ~exitWriter ()
+    {
+      const char* path = getenv ("SCOPE_TRACE_FILE");
+      if (!path)
+	return;
+      std::ofstream out (path);
+      writeChromeTrace (out);
+    }
+  };
+
+  static registry&
+  theRegistry ()
+  {
+    // never destroyed, threads may still trace during static destruction
+    static registry* r = new registry ();
+    static exitWriter writer;
+    return *r;
+  }
+
+  ///
+  /// Opens cycles, instructions and cache misses of the calling thread as one group, the leader
+  /// fd reads all three. false when any of them is not available.
+  ///
+  static bool
+  openCounters (int* fds)
+  {
+    static const uint64_t configs[s_counters] =
+      { PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES };
+    for (int c = 0; c < s_counters; ++c)
+      {
+	perf_event_attr attr;
+	memset (&attr, 0, sizeof(attr));
+	attr.size = sizeof(attr);
+	attr.type = PERF_TYPE_HARDWARE;
+	attr.config = configs[c];
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	attr.read_format = PERF_FORMAT_GROUP;
+	fds[c] = int (syscall (SYS_perf_event_open, &attr, 0, -1, c ? fds[0] : -1, 0));
+	if (fds[c] < 0)
+	  {
+	    while (c-- > 0)
+	      close (fds[c]);
+	    return false;
+	  }
+      }
+    return true;
+  }
+};
+
+///
+/// Records one event for its lifetime, use through TRACE_SCOPE
+///
+class scopeTraceMarker
+{
+public:
+  explicit
+  scopeTraceMarker (const char* name) :
+      m_name (name), m_buffer (scopeTrace::threadBuffer ())
+  {
+    m_counted = m_buffer.readCounters (m_counters);
+    m_start = scopeTrace::now ();
+  }
+  ~scopeTraceMarker ()
+  {
+    uint64_t end = scopeTrace::now ();
+    uint64_t head = m_buffer.m_head.load (std::memory_order_relaxed);
+    traceEvent& e = m_buffer.m_events[head & (scopeTrace::s_traceEvents - 1)];
+    e.name = m_name;
+    e.start = m_start;
+    e.duration = end - m_start;
+    uint64_t counters[scopeTrace::s_counters];
+    bool counted = m_counted && m_buffer.readCounters (counters);
+    for (int c = 0; c < scopeTrace::s_counters; ++c)
+      e.counters[c] = counted ? counters[c] - m_counters[c] : 0;
+    m_buffer.m_head.store (head + 1, std::memory_order_release);
+  }
+  scopeTraceMarker (const scopeTraceMarker&) = delete;
+  scopeTraceMarker&
+  operator = (const scopeTraceMarker&) = delete;
+
+private:
+  const char* m_name;
+  scopeTrace::buffer& m_buffer;
+  uint64_t m_start;
+  uint64_t m_counters[scopeTrace::s_counters];
+  bool m_counted;
+};
+
+#define TRACE_SCOPE_JOIN2(a, b) a##b
+#define TRACE_SCOPE_JOIN(a, b) TRACE_SCOPE_JOIN2 (a, b)
+#define TRACE_SCOPE(name) scopeTraceMarker TRACE_SCOPE_JOIN (scopeTraceMarker_, __LINE__) (name)
+
+#else
+
+class scopeTrace
+{
+public:
+  static const bool enabled = false;
+
+  static bool
+  countersAvailable ()
+  {
+    return false;
+  }
+  static void
+  writeChromeTrace (std::ostream& os)
+  {
+    os << "{\"traceEvents\":[]}\n";
+  }
+};
+
+#define TRACE_SCOPE(name) ((void) 0)
+
+#endif /* SCOPE_TRACE */
+
+#endif /* SCOPETRACE_H_ */
@@ -0,0 +1,374 @@
+/****************************************************************************************************/
+/*                                                                                                  */
+/* @module        : Cpp 11 features examples                                                        */
+/* @file          : search.h                                                                        */
+/* @brief         : Zero copy linear (SIMD, multi threaded) and sorted searches over arrays         */
+/* @input         :                                                                                 */
+/* @outpu         :                                                                                 */
+/* @date          : 16-October-2026                                                                 */
+/* @author        : Pratik Patil                                                                    */
+/* License        :                                                                                 */
+/*               Copyright (C) 2017  Pratik Patil                                                   */
+/*                                                                                                  */
+/*               This program is free software: you can redistribute it and/or modify               */
+/*               it under the terms of the GNU General Public License Version 3 as published by     */
+/*               the Free Software Foundation.                                                      */
+/*                                                                                                  */
+/*               This program is distributed in the hope that it will be useful,                    */
+/*               but WITHOUT ANY WARRANTY; without even the implied warranty of                     */
+/*               MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                      */
+/*               GNU General Public License for more details.                                       */
+/*                                                                                                  */
+/*               You should have received a copy of the GNU General Public License                  */
+/*               along with this program.  If not, see <http://www.gnu.org/licenses/>.              */
+/****************************************************************************************************/
+#ifndef SEARCH_H_
+#define SEARCH_H_
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include "threadPool.h"
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+#include <immintrin.h>
+#define SEARCH_X86 1
+#endif
+
+/*
+ * Description:
+ *   All searches take a [first, last) range of the caller's array, nothing is copied. They return a
+ *   pointer to the element found, or last when there is none, just like std::find_if.
+ *
+ *   searchFirst (first, last, pred)          - first element for which pred is true
+ *   searchFirst (first, last, greaterThan(v)) - same, but for int, float and double the compare is
+ *                                              done with SIMD, 4 or 8 elements per compare, and the
+ *                                              movemask of the result tells if and where it matched
+ *   parallelSearchFirst                      - splits a big range in blocks run on pool (default
+ *                                              threadPool::global ()). A block with a match
+ *                                              publishes it, blocks behind that match are skipped.
+ *   sortedLowerBound / sortedUpperBound      - branchless binary search on sorted data
+ *   gallopUpperBound                         - exponential probe from the front followed by binary
+ *                                              search, for when the answer tends to be near first
+ */
+
+enum searchCompare
+{
+  searchLess, searchGreater, searchEqual
+};
+
+///
+/// Arithmetic predicate "x OP value" the SIMD search understands
+///
+template<searchCompare OP, class T>
+  struct searchFor
+  {
+    T value;
+
+    bool
+    operator () (T x) const
+    {
+      return OP == searchLess ? x < value : OP == searchGreater ? value < x : x == value;
+    }
+  };
+
+template<class T>
+  inline searchFor<searchGreater, T>
+  greaterThan (T value)
+  {
+    searchFor<searchGreater, T> p =
+      { value };
+    return p;
+  }
+template<class T>
+  inline searchFor<searchLess, T>
+  lessThan (T value)
+  {
+    searchFor<searchLess, T> p =
+      { value };
+    return p;
+  }
+template<class T>
+  inline searchFor<searchEqual, T>
+  equalTo (T value)
+  {
+    searchFor<searchEqual, T> p =
+      { value };
+    return p;
+  }
+
+template<class T, class PRED>
+  inline const T*
+  searchFirst (const T* first, const T* last, PRED pred)
+  {
+    for (; first != last; ++first)
+      if (pred (*first))
+	return first;
+    return last;
+  }
+
+#ifdef SEARCH_X86
+/*
+ * Per type SIMD operations. compare() gives all ones lanes where "x OP value" holds, mask() packs
+ * one bit per lane so the first match is the lowest set bit.
+ */
+template<class T>
+  struct searchSimd
+  {
+    static const bool supported = false;
+  };
+
+template<>
+  struct searchSimd<int>
+  {
+    static const bool supported = true;
+    static const size_t lanes = 4;
+    static const size_t lanesAvx2 = 8;
+
+    template<searchCompare OP>
+      static int
+      mask (const int* p, __m128i v)
+      {
+	__m128i x = _mm_loadu_si128 ((const __m128i *) p);
+	__m128i m = OP == searchLess ? _mm_cmplt_epi32 (x, v) :
+		    OP == searchGreater ? _mm_cmpgt_epi32 (x, v) : _mm_cmpeq_epi32 (x, v);
+	return _mm_movemask_ps (_mm_castsi128_ps (m));
+      }
+    static __m128i
+    splat (int value)
+    {
+      return _mm_set1_epi32 (value);
+    }
+
+    template<searchCompare OP>
+      __attribute__((target("avx2"))) static int
+      maskAvx2 (const int* p, int value)
+      {
+	__m256i v = _mm256_set1_epi32 (value);
+	__m256i x = _mm256_loadu_si256 ((const __m256i *) p);
+	__m256i m = OP == searchLess ? _mm256_cmpgt_epi32 (v, x) :
+		    OP == searchGreater ? _mm256_cmpgt_epi32 (x, v) : _mm256_cmpeq_epi32 (x, v);
+	return _mm256_movemask_ps (_mm256_castsi256_ps (m));
+      }
+  };
+
+template<>
+  struct searchSimd<float>
+  {
+    static const bool supported = true;
+    static const size_t lanes = 4;
+    static const size_t lanesAvx2 = 8;
+
+    template<searchCompare OP>
+      static int
+      mask (const float* p, __m128 v)
+      {
+	__m128 x = _mm_loadu_ps (p);
+	__m128 m = OP == searchLess ? _mm_cmplt_ps (x, v) :
+		   OP == searchGreater ? _mm_cmpgt_ps (x, v) : _mm_cmpeq_ps (x, v);
+	return _mm_movemask_ps (m);
+      }
+    static __m128
+    splat (float value)
+    {
+      return _mm_set1_ps (value);
+    }
+
+    template<searchCompare OP>
+      __attribute__((target("avx2"))) static int
+      maskAvx2 (const float* p, float value)
+      {
+	__m256 v = _mm256_set1_ps (value);
+	__m256 x = _mm256_loadu_ps (p);
+	__m256 m = OP == searchLess ? _mm256_cmp_ps (x, v, _CMP_LT_OQ) :
+		   OP == searchGreater ? _mm256_cmp_ps (x, v, _CMP_GT_OQ) :
+					 _mm256_cmp_ps (x, v, _CMP_EQ_OQ);
+	return _mm256_movemask_ps (m);
+      }
+  };
+
+template<>
+  struct searchSimd<double>
+  {
+    static const bool supported = true;
+    static const size_t lanes = 2;
+    static const size_t lanesAvx2 = 4;
+
+    template<searchCompare OP>
+      static int
+      mask (const double* p, __m128d v)
+      {
+	__m128d x = _mm_loadu_pd (p);
+	__m128d m = OP == searchLess ? _mm_cmplt_pd (x, v) :
+		    OP == searchGreater ? _mm_cmpgt_pd (x, v) : _mm_cmpeq_pd (x, v);
+	return _mm_movemask_pd (m);
+      }
+    static __m128d
+    splat (double value)
+    {
+      return _mm_set1_pd (value);
+    }
+
+    template<searchCompare OP>
+      __attribute__((target("avx2"))) static int
+      maskAvx2 (const double* p, double value)
+      {
+	__m256d v = _mm256_set1_pd (value);
+	__m256d x = _mm256_loadu_pd (p);
+	__m256d m = OP == searchLess ? _mm256_cmp_pd (x, v, _CMP_LT_OQ) :
+		    OP == searchGreater ? _mm256_cmp_pd (x, v, _CMP_GT_OQ) :
+					  _mm256_cmp_pd (x, v, _CMP_EQ_OQ);
+	return _mm256_movemask_pd (m);
+      }
+  };
+
+inline bool
+searchHasAvx2 ()
+{
+  static const bool avx2 = (__builtin_cpu_init (), __builtin_cpu_supports ("avx2"));
+  return avx2;
+}
+
+template<searchCompare OP, class T>
+  __attribute__((target("avx2"))) const T*
+  searchFirstAvx2 (const T* first, const T* last, T value)
+  {
+    typedef searchSimd<T> simd;
+    size_t n = last - first;
+    size_t i = 0;
+    // two vectors per step, one branch for both
+    for (; i + 2 * simd::lanesAvx2 <= n; i += 2 * simd::lanesAvx2)
+      {
+	int lo = simd::template maskAvx2<OP> (first + i, value);
+	int hi = simd::template maskAvx2<OP> (first + i + simd::lanesAvx2, value);
+	if (lo | hi)
+	  return first + i + (lo ? __builtin_ctz (lo) : simd::lanesAvx2 + __builtin_ctz (hi));
+      }
+    for (; i < n; ++i)
+      if (OP == searchLess ? first[i] < value : OP == searchGreater ? value < first[i] :
+	  first[i] == value)
+	return first + i;
+    return last;
+  }
+
+template<searchCompare OP, class T>
+  inline typename std::enable_if<searchSimd<T>::supported, const T*>::type
+  searchFirst (const T* first, const T* last, searchFor<OP, T> pred)
+  {
+    typedef searchSimd<T> simd;
+    if (searchHasAvx2 ())
+      return searchFirstAvx2<OP> (first, last, pred.value);
+    auto v = simd::splat (pred.value);
+    size_t n = last - first;
+    size_t i = 0;
+    for (; i + 2 * simd::lanes <= n; i += 2 * simd::lanes)
+      {
+	int lo = simd::template mask<OP> (first + i, v);
+	int hi = simd::template mask<OP> (first + i + simd::lanes, v);
+	if (lo | hi)
+	  return first + i + (lo ? __builtin_ctz (lo) : simd::lanes + __builtin_ctz (hi));
+      }
+    for (; i < n; ++i)
+      if (pred (first[i]))
+	return first + i;
+    return last;
+  }
+#endif
+
+///
+/// Elements per block of parallelSearchFirst, small enough that a late match wastes little work
+///
+struct searchLimits
+{
+  static const size_t s_searchBlock = 1 << 16;
+};
+
+template<class T, class PRED>
+  const T*
+  parallelSearchFirst (const T* first, const T* last, PRED pred,
+		       threadPool& pool = threadPool::global ())
+  {
+    size_t n = last - first;
+    if (pool.size () < 2 || n < 2 * searchLimits::s_searchBlock)
+      return searchFirst (first, last, pred);
+
+    // Lowest matching index found so far, n while there is none
+    std::atomic<size_t> found (n);
+    pool.forRange (0, n, searchLimits::s_searchBlock, [&](size_t begin, size_t end)
+      {
+	// A match before this block was already found, nothing here can beat it
+	if (found.load (std::memory_order_relaxed) < begin)
+	  return;
+	const T* p = searchFirst (first + begin, first + end, pred);
+	if (p != first + end)
+	  {
+	    size_t index = p - first;
+	    size_t current = found.load (std::memory_order_relaxed);
+	    while (index < current && !found.compare_exchange_weak (current, index))
+	      ;
+	  }
+      });
+    return first + found.load ();
+  }
+
+///
+/// First element which is not less than value. Branchless: the loop always runs log2(n) times and
+/// the comparison only selects the next base, which compiles to a conditional move.
+///
+template<class T>
+  const T*
+  sortedLowerBound (const T* first, const T* last, const T& value)
+  {
+    size_t n = last - first;
+    if (n == 0)
+      return last;
+    const T* base = first;
+    while (n > 1)
+      {
+	size_t half = n / 2;
+	base = base[half] < value ? base + half : base;
+	n -= half;
+      }
+    return base + (*base < value);
+  }
+
+///
+/// First element greater than value, i.e. searchFirst (first, last, greaterThan (value)) on sorted data
+///
+template<class T>
+  const T*
+  sortedUpperBound (const T* first, const T* last, const T& value)
+  {
+    size_t n = last - first;
+    if (n == 0)
+      return last;
+    const T* base = first;
+    while (n > 1)
+      {
+	size_t half = n / 2;
+	base = value < base[half] ? base : base + half;
+	n -= half;
+      }
+    return base + !(value < *base);
+  }
+
+///
+/// sortedUpperBound, but probes first[0], first[2], first[6], first[14] ... to bound the answer
+/// before the binary search. O(log k) for an answer at position k.
+///
+template<class T>
+  const T*
+  gallopUpperBound (const T* first, const T* last, const T& value)
+  {
+    size_t n = last - first;
+    size_t lo = 0;
+    size_t step = 1;
+    while (lo + step <= n && !(value < first[lo + step - 1]))
+      {
+	lo += step;
+	step *= 2;
+      }
+    size_t hi = lo + step < n ? lo + step : n;
+    return sortedUpperBound (first + lo, first + hi, value);
+  }
+
+#endif /* SEARCH_H_ */
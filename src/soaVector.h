@@ -0,0 +1,478 @@
+/****************************************************************************************************/
+/*                                                                                                  */
+/* @module        : Cpp 11 features examples                                                        */
+/* @file          : soaVector.h                                                                     */
+/* @brief         : Struct of arrays container with proxy references and column kernels             */
+/* @input         :                                                                                 */
+/* @outpu         :                                                                                 */
+/* @date          : 16-October-2026                                                                 */
+/* @author        : Pratik Patil                                                                    */
+/* License        :                                                                                 */
+/*               Copyright (C) 2017  Pratik Patil                                                   */
+/*                                                                                                  */
+/*               This program is free software: you can redistribute it and/or modify               */
+/*               it under the terms of the GNU General Public License Version 3 as published by     */
+/*               the Free Software Foundation.                                                      */
+/*                                                                                                  */
+/*               This program is distributed in the hope that it will be useful,                    */
+/*               but WITHOUT ANY WARRANTY; without even the implied warranty of                     */
+/*               MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                      */
+/*               GNU General Public License for more details.                                       */
+/*                                                                                                  */
+/*               You should have received a copy of the GNU General Public License                  */
+/*               along with this program.  If not, see <http://www.gnu.org/licenses/>.              */
+/****************************************************************************************************/
+#ifndef SOAVECTOR_H_
+#define SOAVECTOR_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/*
+ * Description:
+ *   std::vector<record> stores records one after the other (array of structs). A loop reading
+ *   only intVal still drags every floatVal, and a vptr if the struct has virtual functions,
+ *   through the cache. soaVector<REF, FIELDS...> stores every field in its own column instead
+ *   (struct of arrays), each column contiguous and 64 byte aligned.
+ *
+ *   REF is a small struct of references, one per field in the same order, e.g.
+ *
+ *     struct defaultConstructorRef { int& intVal; float& floatVal; };
+ *     soaVector<defaultConstructorRef, int, float> records;
+ *     records.push_back (1, 2.5f);
+ *     for (defaultConstructorRef rec : records)
+ *       rec.intVal += 1;
+ *
+ *   so code working on records keeps reading rec.intVal. Iteration hands out REF by value, it
+ *   refers into the columns. A const soaVector hands out std::tuple<const FIELDS&...> instead,
+ *   read with std::get<I>.
+ *
+ *   Column kernels -
+ *   column<I> () is the raw array of field I. mapColumn, countIf and filter run a lambda over
+ *   one column only: a plain loop over aligned, contiguous data of one type which the compiler
+ *   vectorizes. filter counts the matches first, then writes the index of each element
+ *   unconditionally and advances the output by the predicate result, so there is no branch to
+ *   mispredict. The indices are size_t, columns may hold more than 2^32 records.
+ */
+
+///
+/// Aligned growable array of trivially copyable T, one column of a soaVector
+///
+template<class T>
+  class soaColumn
+  {
+    static_assert (std::is_trivially_copyable<T>::value,
+	"soaColumn grows with memcpy, T must be trivially copyable");
+
+  public:
+    static const size_t s_alignment = 64;
+
+    soaColumn () :
+	m_raw (nullptr), m_data (nullptr), m_size (0), m_capacity (0)
+    {
+    }
+    ~soaColumn ()
+    {
+      ::operator delete (m_raw);
+    }
+    soaColumn (const soaColumn&) = delete;
+    soaColumn&
+    operator = (const soaColumn&) = delete;
+    soaColumn (soaColumn&& c) noexcept :
+	m_raw (c.m_raw), m_data (c.m_data), m_size (c.m_size), m_capacity (c.m_capacity)
+    {
+      c.m_raw = nullptr;
+      c.m_data = nullptr;
+      c.m_size = c.m_capacity = 0;
+    }
+
+    T*
+    data ()
+    {
+      return m_data;
+    }
+    const T*
+    data () const
+    {
+      return m_data;
+    }
+    T*
+    begin ()
+    {
+      return m_data;
+    }
+    T*
+    end ()
+    {
+      return m_data + m_size;
+    }
+    const T*
+    begin () const
+    {
+      return m_data;
+    }
+    const T*
+    end () const
+    {
+      return m_data + m_size;
+    }
+    size_t
+    size () const
+    {
+      return m_size;
+    }
+
+    void
+    reserve (size_t capacity)
+    {
+      if (capacity <= m_capacity)
+	return;
+      void* raw = ::operator new (capacity * sizeof(T) + s_alignment);
+      T* data = reinterpret_cast<T*> ((reinterpret_cast<uintptr_t> (raw) + s_alignment - 1)
+	  & ~uintptr_t (s_alignment - 1));
+      if (m_size)
+	memcpy (data, m_data, m_size * sizeof(T));
+      ::operator delete (m_raw);
+      m_raw = raw;
+      m_data = data;
+      m_capacity = capacity;
+    }
+    void
+    push_back (const T& value)
+    {
+      if (m_size == m_capacity)
+	reserve (m_capacity ? m_capacity * 2 : 16);
+      m_data[m_size++] = value;
+    }
+    void
+    resize (size_t size)
+    {
+      reserve (size);
+      for (size_t i = m_size; i < size; ++i)
+	m_data[i] = T ();
+      m_size = size;
+    }
+
+  private:
+    void* m_raw;
+    T* m_data;
+    size_t m_size;
+    size_t m_capacity;
+  };
+
+template<size_t... IS>
+  struct soaIndices
+  {
+  };
+template<size_t N, size_t... IS>
+  struct soaMakeIndices : soaMakeIndices<N - 1, N - 1, IS...>
+  {
+  };
+template<size_t... IS>
+  struct soaMakeIndices<0, IS...>
+  {
+    typedef soaIndices<IS...> type;
+  };
+
+///
+/// Random access iterator of a soaVector, R is what it hands out: the REF of the vector, or a tuple
+/// of const references for a const vector
+///
+template<class VECTOR, class R>
+  class soaIterator
+  {
+  public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef R value_type;
+    typedef ptrdiff_t difference_type;
+    typedef void pointer;
+    typedef R reference;
+
+    soaIterator (VECTOR* v, size_t i) :
+	m_vector (v), m_index (i)
+    {
+    }
+    R
+    operator * () const
+    {
+      return (*m_vector)[m_index];
+    }
+    R
+    operator [] (ptrdiff_t n) const
+    {
+      return (*m_vector)[m_index + n];
+    }
+    soaIterator&
+    operator ++ ()
+    {
+      ++m_index;
+      return *this;
+    }
+    soaIterator
+    operator ++ (int)
+    {
+      soaIterator old (*this);
+      ++m_index;
+      return old;
+    }
+    soaIterator&
+    operator -- ()
+    {
+      --m_index;
+      return *this;
+    }
+    soaIterator
+    operator -- (int)
+    {
+      soaIterator old (*this);
+      --m_index;
+      return old;
+    }
+    soaIterator&
+    operator += (ptrdiff_t n)
+    {
+      m_index += n;
+      return *this;
+    }
+    soaIterator&
+    operator -= (ptrdiff_t n)
+    {
+      m_index -= n;
+      return *this;
+    }
+    soaIterator
+    operator + (ptrdiff_t n) const
+    {
+      return soaIterator (m_vector, m_index + n);
+    }
+    friend soaIterator
+    operator + (ptrdiff_t n, const soaIterator& it)
+    {
+      return it + n;
+    }
+    soaIterator
+    operator - (ptrdiff_t n) const
+    {
+      return soaIterator (m_vector, m_index - n);
+    }
+    ptrdiff_t
+    operator - (const soaIterator& rhs) const
+    {
+      return ptrdiff_t (m_index) - ptrdiff_t (rhs.m_index);
+    }
+    bool
+    operator == (const soaIterator& rhs) const
+    {
+      return m_index == rhs.m_index;
+    }
+    bool
+    operator != (const soaIterator& rhs) const
+    {
+      return m_index != rhs.m_index;
+    }
+    bool
+    operator < (const soaIterator& rhs) const
+    {
+      return m_index < rhs.m_index;
+    }
+    bool
+    operator > (const soaIterator& rhs) const
+    {
+      return m_index > rhs.m_index;
+    }
+    bool
+    operator <= (const soaIterator& rhs) const
+    {
+      return m_index <= rhs.m_index;
+    }
+    bool
+    operator >= (const soaIterator& rhs) const
+    {
+      return m_index >= rhs.m_index;
+    }
+
+  private:
+    VECTOR* m_vector;
+    size_t m_index;
+  };
+
+template<class REF, class ... FIELDS>
+  class soaVector
+  {
+  public:
+    typedef REF reference;
+    typedef typename soaMakeIndices<sizeof...(FIELDS)>::type indices;
+
+    template<size_t I>
+      using field = typename std::tuple_element<I, std::tuple<FIELDS...> >::type;
+
+    typedef std::tuple<const FIELDS&...> const_reference;
+    typedef soaIterator<soaVector, REF> iterator;
+    typedef soaIterator<const soaVector, const_reference> const_iterator;
+
+    size_t
+    size () const
+    {
+      return std::get<0> (m_columns).size ();
+    }
+    bool
+    empty () const
+    {
+      return size () == 0;
+    }
+    void
+    reserve (size_t capacity)
+    {
+      reserveColumns (capacity, indices ());
+    }
+    void
+    resize (size_t size)
+    {
+      resizeColumns (size, indices ());
+    }
+    void
+    push_back (const FIELDS&... values)
+    {
+      pushColumns (indices (), values...);
+    }
+
+    REF
+    operator [] (size_t i)
+    {
+      return makeRef (i, indices ());
+    }
+    const_reference
+    operator [] (size_t i) const
+    {
+      return makeConstRef (i, indices ());
+    }
+    iterator
+    begin ()
+    {
+      return iterator (this, 0);
+    }
+    iterator
+    end ()
+    {
+      return iterator (this, size ());
+    }
+    const_iterator
+    begin () const
+    {
+      return const_iterator (this, 0);
+    }
+    const_iterator
+    end () const
+    {
+      return const_iterator (this, size ());
+    }
+
+    template<size_t I>
+      field<I>*
+      column ()
+      {
+	return std::get<I> (m_columns).data ();
+      }
+    template<size_t I>
+      const field<I>*
+      column () const
+      {
+	return std::get<I> (m_columns).data ();
+      }
+
+    ///
+    /// column<I>[i] = f (column<I>[i]) for every record
+    ///
+    template<size_t I, class FUNC>
+      void
+      mapColumn (FUNC f)
+      {
+	field<I>* __restrict__ c = column<I> ();
+	size_t n = size ();
+	for (size_t i = 0; i < n; ++i)
+	  c[i] = f (c[i]);
+      }
+
+    template<size_t I, class PRED>
+      size_t
+      countIf (PRED pred) const
+      {
+	const field<I>* __restrict__ c = column<I> ();
+	size_t n = size ();
+	size_t count = 0;
+	for (size_t i = 0; i < n; ++i)
+	  count += pred (c[i]) ? 1 : 0;
+	return count;
+      }
+
+    ///
+    /// Indices of the records whose field I satisfies pred
+    ///
+    template<size_t I, class PRED>
+      std::vector<size_t>
+      filter (PRED pred) const
+      {
+	// Counting first (a vectorized pass) keeps the output small for selective predicates
+	std::vector<size_t> out (countIf<I> (pred) + 1);
+	const field<I>* __restrict__ c = column<I> ();
+	size_t n = size ();
+	size_t found = 0;
+	for (size_t i = 0; i < n; ++i)
+	  {
+	    out[found] = i;
+	    found += pred (c[i]) ? 1 : 0;
+	  }
+	out.resize (found);
+	return out;
+      }
+
+  private:
+    std::tuple<soaColumn<FIELDS> ...> m_columns;
+
+    template<size_t... IS>
+      REF
+      makeRef (size_t i, soaIndices<IS...>)
+      {
+	return REF
+	  { std::get<IS> (m_columns).data ()[i]... };
+      }
+    template<size_t... IS>
+      const_reference
+      makeConstRef (size_t i, soaIndices<IS...>) const
+      {
+	return const_reference (std::get<IS> (m_columns).data ()[i]...);
+      }
+    template<size_t... IS>
+      void
+      reserveColumns (size_t capacity, soaIndices<IS...>)
+      {
+	int expand[] =
+	  { (std::get<IS> (m_columns).reserve (capacity), 0)... };
+	(void) expand;
+      }
+    template<size_t... IS>
+      void
+      resizeColumns (size_t size, soaIndices<IS...>)
+      {
+	int expand[] =
+	  { (std::get<IS> (m_columns).resize (size), 0)... };
+	(void) expand;
+      }
+    template<size_t... IS>
+      void
+      pushColumns (soaIndices<IS...>, const FIELDS&... values)
+      {
+	int expand[] =
+	  { (std::get<IS> (m_columns).push_back (values), 0)... };
+	(void) expand;
+      }
+  };
+
+#endif /* SOAVECTOR_H_ */
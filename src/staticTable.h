@@ -0,0 +1,208 @@
+/****************************************************************************************************/
+/*                                                                                                  */
+/* @module        : Cpp 11 features examples                                                        */
+/* @file          : staticTable.h                                                                   */
+/* @brief         : Read only key/value tables laid out and checked at compile time                 */
+/* @input         :                                                                                 */
+/* @outpu         :                                                                                 */
+/* @date          : 16-October-2026                                                                 */
+/* @author        : Pratik Patil                                                                    */
+/* License        :                                                                                 */
+/*               Copyright (C) 2017  Pratik Patil                                                   */
+/*                                                                                                  */
+/*               This program is free software: you can redistribute it and/or modify               */
+/*               it under the terms of the GNU General Public License Version 3 as published by     */
+/*               the Free Software Foundation.                                                      */
+/*                                                                                                  */
+/*               This program is distributed in the hope that it will be useful,                    */
+/*               but WITHOUT ANY WARRANTY; without even the implied warranty of                     */
+/*               MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                      */
+/*               GNU General Public License for more details.                                       */
+/*                                                                                                  */
+/*               You should have received a copy of the GNU General Public License                  */
+/*               along with this program.  If not, see <http://www.gnu.org/licenses/>.              */
+/****************************************************************************************************/
+#ifndef STATICTABLE_H_
+#define STATICTABLE_H_
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+/*
+ * Description:
+ *   A std::map filled from a brace list is built at startup: one allocation per node plus the
+ *   string copies and tree rebalancing. For data known when compiling, a constexpr array of
+ *   staticEntry is laid out by the compiler in read only memory instead, and costs nothing at
+ *   startup:
+ *
+ *     constexpr staticEntry<const char*> singerEntries[] =
+ *       {
+ *         { "Beyonce Knowles", "+1 (212) 555-0987" },
+ *         { "Lady Gaga", "+1 (212) 555-7890" } };
+ *     constexpr auto singers = makeStaticTable (singerEntries);
+ *     static_assert (singers.sorted (), "singers must be sorted by name");
+ *
+ *   The entries are kept sorted by key (plain byte order, like strcmp), so lookup is a binary
+ *   search over one dense array. C++11 constexpr functions can't reorder an array, so the order is
+ *   not established by the compiler but checked by it: sorted () is a constant expression and the
+ *   static_assert fails the build when someone adds an entry in the wrong place or twice.
+ *
+ *   lookup () is constexpr too, so a key can be resolved at compile time. find () is the same
+ *   search for run time, comparing with memcmp.
+ *
+ *   The constexpr recursion is only log2(n) deep over entries and as deep as the key is long when
+ *   comparing keys, so tables of many thousands of entries stay inside the compiler's limits.
+ */
+
+template<class V>
+  struct staticEntry
+  {
+    const char* key;
+    size_t length;
+    V value;
+
+    template<size_t N>
+      constexpr
+      staticEntry (const char (&k)[N], const V& v) :
+	  key (k), length (N - 1), value (v)
+      {
+      }
+  };
+
+///
+/// strcmp like compare of (a, al) and (b, bl), usable in constant expressions
+///
+constexpr int
+staticCompare (const char* a, size_t al, const char* b, size_t bl, size_t i = 0)
+{
+  return i == al ? (i == bl ? 0 : -1) :
+	 i == bl ? 1 :
+	 a[i] != b[i] ? ((unsigned char) a[i] < (unsigned char) b[i] ? -1 : 1) :
+	 staticCompare (a, al, b, bl, i + 1);
+}
+
+template<class V, size_t N>
+  class staticTable
+  {
+  public:
+    constexpr
+    staticTable (const staticEntry<V> (&entries)[N]) :
+	m_entries (entries)
+    {
+    }
+
+    constexpr size_t
+    size () const
+    {
+      return N;
+    }
+    constexpr const staticEntry<V>*
+    begin () const
+    {
+      return m_entries;
+    }
+    constexpr const staticEntry<V>*
+    end () const
+    {
+      return m_entries + N;
+    }
+
+    ///
+    /// True if keys are strictly increasing, i.e. sorted and without duplicates
+    ///
+    constexpr bool
+    sorted () const
+    {
+      return sortedRange (0, N);
+    }
+
+    ///
+    /// Value of key, nullptr if it's not in the table. Can be evaluated at compile time.
+    ///
+    constexpr const V*
+    lookup (const char* key, size_t length) const
+    {
+      return lookupRange (key, length, 0, N);
+    }
+
+    const V*
+    find (const char* key, size_t length) const
+    {
+      size_t lo = 0;
+      size_t hi = N;
+      while (lo < hi)
+	{
+	  size_t mid = lo + (hi - lo) / 2;
+	  const staticEntry<V>& e = m_entries[mid];
+	  int c = memcmp (key, e.key, length < e.length ? length : e.length);
+	  if (c == 0)
+	    c = length < e.length ? -1 : length > e.length ? 1 : 0;
+	  if (c == 0)
+	    return &e.value;
+	  if (c < 0)
+	    hi = mid;
+	  else
+	    lo = mid + 1;
+	}
+      return nullptr;
+    }
+    const V*
+    find (const std::string& key) const
+    {
+      return find (key.data (), key.size ());
+    }
+    const V*
+    find (const char* key) const
+    {
+      return find (key, strlen (key));
+    }
+
+  private:
+    const staticEntry<V>* m_entries;
+
+    constexpr bool
+    sortedRange (size_t lo, size_t hi) const
+    {
+      // split in halves and check the pair across the cut, recursion depth stays log2(N)
+      return hi - lo < 2 ? true :
+	     sortedRange (lo, lo + (hi - lo) / 2) && sortedRange (lo + (hi - lo) / 2, hi)
+		 && staticCompare (m_entries[lo + (hi - lo) / 2 - 1].key,
+				   m_entries[lo + (hi - lo) / 2 - 1].length,
+				   m_entries[lo + (hi - lo) / 2].key,
+				   m_entries[lo + (hi - lo) / 2].length) < 0;
+    }
+    constexpr const V*
+    lookupRange (const char* key, size_t length, size_t lo, size_t hi) const
+    {
+      return lo >= hi ? nullptr :
+	     lookupAt (key, length, lo, hi, lo + (hi - lo) / 2,
+		       staticCompare (key, length, m_entries[lo + (hi - lo) / 2].key,
+				      m_entries[lo + (hi - lo) / 2].length));
+    }
+    constexpr const V*
+    lookupAt (const char* key, size_t length, size_t lo, size_t hi, size_t mid, int c) const
+    {
+      return c == 0 ? &m_entries[mid].value :
+	     c < 0 ? lookupRange (key, length, lo, mid) : lookupRange (key, length, mid + 1, hi);
+    }
+  };
+
+template<class V, size_t N>
+  constexpr staticTable<V, N>
+  makeStaticTable (const staticEntry<V> (&entries)[N])
+  {
+    return staticTable<V, N> (entries);
+  }
+
+///
+/// Length of a string literal, for compile time lookups: lookup (key, staticLength (key))
+///
+template<size_t N>
+  constexpr size_t
+  staticLength (const char (&)[N])
+  {
+    return N - 1;
+  }
+
+#endif /* STATICTABLE_H_ */
@@ -0,0 +1,154 @@
+/****************************************************************************************************/
+/*                                                                                                  */
+/* @module        : Cpp 11 features examples                                                        */
+/* @file          : tagDispatcher.h                                                                 */
+/* @brief         : Handlers bound to tag types at compile time, called directly                    */
+/* @input         :                                                                                 */
+/* @outpu         :                                                                                 */
+/* @date          : 16-October-2026                                                                 */
+/* @author        : Pratik Patil                                                                    */
+/* License        :                                                                                 */
+/*               Copyright (C) 2017  Pratik Patil                                                   */
+/*                                                                                                  */
+/*               This program is free software: you can redistribute it and/or modify               */
+/*               it under the terms of the GNU General Public License Version 3 as published by     */
+/*               the Free Software Foundation.                                                      */
+/*                                                                                                  */
+/*               This program is distributed in the hope that it will be useful,                    */
+/*               but WITHOUT ANY WARRANTY; without even the implied warranty of                     */
+/*               MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                      */
+/*               GNU General Public License for more details.                                       */
+/*                                                                                                  */
+/*               You should have received a copy of the GNU General Public License                  */
+/*               along with this program.  If not, see <http://www.gnu.org/licenses/>.              */
+/****************************************************************************************************/
+#ifndef TAGDISPATCHER_H_
+#define TAGDISPATCHER_H_
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+/*
+ * Description:
+ *   funct (int) and funct (char*) in nullptr_delegatingConstructors.cpp are picked by the compiler
+ *   from the argument type; nothing is decided at run time. A callback registry, a map from message
+ *   type to std::function, makes the same choice at run time with an indirect call the compiler can
+ *   see through neither.
+ *
+ *   tagDispatcher keeps that choice at compile time. Every handler is bound to a tag type, the
+ *   dispatcher stores the handlers by value in a tuple, and
+ *   - dispatcher (TAG (), args...) finds the handler of TAG while compiling and calls it directly,
+ *     so it can be inlined. A tag without handler does not compile.
+ *   - dispatcher.call<R> (index, args...) is for ids only known at run time (e.g. read from a
+ *     message): a chain of compares over the handlers in order, which the compiler turns into a
+ *     jump table or a few branches with the handler bodies inlined. Every handler must accept
+ *     args, an index without handler returns R ().
+ *
+ *     struct intTag {}; struct pointerTag {};
+ *     auto dispatcher = makeTagDispatcher (onTag<intTag> ([](int v) { ... }),
+ *                                          onTag<pointerTag> ([](char* p) { ... }));
+ *     dispatcher (intTag (), 0);
+ */
+
+template<class TAG, class HANDLER>
+  struct tagHandler
+  {
+    typedef TAG tag;
+    HANDLER handler;
+  };
+
+template<class TAG, class HANDLER>
+  tagHandler<TAG, typename std::decay<HANDLER>::type>
+  onTag (HANDLER&& handler)
+  {
+    return tagHandler<TAG, typename std::decay<HANDLER>::type>
+      { std::forward<HANDLER> (handler) };
+  }
+
+///
+/// Position of the entry for TAG in ENTRIES, sizeof...(ENTRIES) if there is none
+///
+template<class TAG, class ... ENTRIES>
+  struct tagIndex;
+
+template<class TAG>
+  struct tagIndex<TAG> : std::integral_constant<size_t, 0>
+  {
+  };
+
+template<class TAG, class ENTRY, class ... ENTRIES>
+  struct tagIndex<TAG, ENTRY, ENTRIES...> : std::integral_constant<size_t,
+      std::is_same<TAG, typename ENTRY::tag>::value ? 0 : 1 + tagIndex<TAG, ENTRIES...>::value>
+  {
+  };
+
+template<class ... ENTRIES>
+  class tagDispatcher
+  {
+  public:
+    static const size_t s_count = sizeof...(ENTRIES);
+
+    explicit
+    tagDispatcher (ENTRIES ... entries) :
+	m_entries (std::move (entries)...)
+    {
+    }
+
+    template<class TAG, class ... ARGS>
+      auto
+      operator () (TAG, ARGS&&... args) ->
+	  decltype(std::get<tagIndex<TAG, ENTRIES...>::value> (std::declval<std::tuple<ENTRIES...>&> ()).handler (std::forward<ARGS> (args)...))
+      {
+	static_assert (tagIndex<TAG, ENTRIES...>::value < s_count, "no handler for this tag");
+	return std::get<tagIndex<TAG, ENTRIES...>::value> (m_entries).handler (
+	    std::forward<ARGS> (args)...);
+      }
+
+    template<class TAG>
+      static constexpr size_t
+      indexOf ()
+      {
+	return tagIndex<TAG, ENTRIES...>::value;
+      }
+
+    template<class R, class ... ARGS>
+      R
+      call (size_t index, ARGS&&... args)
+      {
+	return callAt<R, 0> (index, std::integral_constant<bool, 0 < s_count> (),
+			     std::forward<ARGS> (args)...);
+      }
+
+  private:
+    std::tuple<ENTRIES...> m_entries;
+
+    template<class R, size_t I, class ... ARGS>
+      R
+      callAt (size_t index, std::true_type, ARGS&&... args)
+      {
+	if (index == I)
+	  return R (std::get<I> (m_entries).handler (std::forward<ARGS> (args)...));
+	return callAt<R, I + 1> (index, std::integral_constant<bool, I + 1 < s_count> (),
+				 std::forward<ARGS> (args)...);
+      }
+    template<class R, size_t I, class ... ARGS>
+      R
+      callAt (size_t, std::false_type, ARGS&&...)
+      {
+	return R ();
+      }
+  };
+
+template<class ... ENTRIES>
+  const size_t tagDispatcher<ENTRIES...>::s_count;
+
+template<class ... ENTRIES>
+  tagDispatcher<ENTRIES...>
+  makeTagDispatcher (ENTRIES ... entries)
+  {
+    return tagDispatcher<ENTRIES...> (std::move (entries)...);
+  }
+
+#endif /* TAGDISPATCHER_H_ */
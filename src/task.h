@@ -0,0 +1,443 @@
+/****************************************************************************************************/
+/*                                                                                                  */
+/* @module        : Cpp 11 features examples                                                        */
+/* @file          : task.h                                                                          */
+/* @brief         : Tasks on the threadPool with continuations, whenAll and cancellation            */
+/* @input         :                                                                                 */
+/* @outpu         :                                                                                 */
+/* @date          : 16-October-2026                                                                 */
+/* @author        : Pratik Patil                                                                    */
+/* License        :                                                                                 */
+/*               Copyright (C) 2017  Pratik Patil                                                   */
+/*                                                                                                  */
+/*               This program is free software: you can redistribute it and/or modify               */
+/*               it under the terms of the GNU General Public License Version 3 as published by     */
+/*               the Free Software Foundation.                                                      */
+/*                                                                                                  */
+/*               This program is distributed in the hope that it will be useful,                    */
+/*               but WITHOUT ANY WARRANTY; without even the implied warranty of                     */
+/*               MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                      */
+/*               GNU General Public License for more details.                                       */
+/*                                                                                                  */
+/*               You should have received a copy of the GNU General Public License                  */
+/*               along with this program.  If not, see <http://www.gnu.org/licenses/>.              */
+/****************************************************************************************************/
+#ifndef TASK_H_
+#define TASK_H_
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "threadPool.h"
+
+/*
+ * Description:
+ *   The lambdas of LambdaExpression.cpp run on the calling thread, one after the other. spawn ()
+ *   runs a lambda on the threadPool and returns a task<T>, a handle to its future result; then ()
+ *   chains the next step and whenAll () joins many tasks into one, so a fan out of independent jobs
+ *   is expressed without a thread per job and without blocking in between:
+ *
+ *     std::vector<task<size_t> > counts;
+ *     for (const std::string& s : lines)
+ *       counts.push_back (spawn ([&s]() { return asciiCountUpper (s.data (), s.size ()); }));
+ *     task<size_t> total = whenAll (counts).then ([](const task<std::vector<size_t> >& all)
+ *       { return std::accumulate (all.get ().begin (), all.get ().end (), size_t (0)); });
+ *     total.get ();                              // waits, running queued pool tasks meanwhile
+ *
+ *   - A continuation runs on the thread completing its task. then () on a task that is already
+ *     done runs the continuation right away on the calling thread: no queueing, no std::function.
+ *     get () on a done task is one atomic load. It returns a reference into the shared state, on a
+ *     temporary task (whenAll (counts).get ()) a copy of the value instead.
+ *   - Exceptions are kept in the task and rethrown by get (), whenAll () fails with the first
+ *     failed task in order.
+ *   - A cancelToken handed to spawn () or then () is checked before the job starts; a cancelled
+ *     job does not run and its task fails with taskCancelled. Running jobs can poll the token
+ *     themselves to stop early. Tasks chained on a cancelled one see taskCancelled from get ().
+ *   - get () / wait () from inside a pool task keep the pool busy by running other queued tasks,
+ *     so waiting on a worker thread does not deadlock a small pool.
+ *
+ *   This is what C++20 coroutines (co_await, task<T>, when_all) are used for; coroutines need
+ *   C++20, these tasks are C++11 and write the continuation as a lambda instead of the rest of the
+ *   function.
+ */
+
+class taskCancelled : public std::runtime_error
+{
+public:
+  taskCancelled () :
+      std::runtime_error ("task cancelled")
+  {
+  }
+};
+
+///
+/// Read side of a cancelSource. A default constructed token is never cancelled.
+///
+class cancelToken
+{
+public:
+  cancelToken () = default;
+  bool
+  cancelled () const
+  {
+    return m_flag && m_flag->load (std::memory_order_acquire);
+  }
+
+private:
+  friend class cancelSource;
+  explicit
+  cancelToken (const std::shared_ptr<std::atomic<bool> >& flag) :
+      m_flag (flag)
+  {
+  }
+  std::shared_ptr<std::atomic<bool> > m_flag;
+};
+
+class cancelSource
+{
+public:
+  cancelSource () :
+      m_flag (std::make_shared<std::atomic<bool> > (false))
+  {
+  }
+  void
+  cancel ()
+  {
+    m_flag->store (true, std::memory_order_release);
+  }
+  bool
+  cancelled () const
+  {
+    return m_flag->load (std::memory_order_acquire);
+  }
+  cancelToken
+  token () const
+  {
+    return cancelToken (m_flag);
+  }
+
+private:
+  std::shared_ptr<std::atomic<bool> > m_flag;
+};
+
+///
+/// Result storage of a task, constructed once the job returns
+///
+template<class T>
+  class taskValue
+  {
+  public:
+    typedef const T& reference;
+
+    taskValue () :
+	m_set (false)
+    {
+    }
+    ~taskValue ()
+    {
+      if (m_set)
+	reinterpret_cast<T*> (&m_storage)->~T ();
+    }
+    taskValue (const taskValue&) = delete;
+    taskValue&
+    operator = (const taskValue&) = delete;
+
+    template<class F>
+      void
+      run (F& f)
+      {
+	new (&m_storage) T (f ());
+	m_set = true;
+      }
+    reference
+    get () const
+    {
+      return *reinterpret_cast<const T*> (&m_storage);
+    }
+
+  private:
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type m_storage;
+    bool m_set;
+  };
+
+template<>
+  class taskValue<void>
+  {
+  public:
+    typedef void reference;
+
+    template<class F>
+      void
+      run (F& f)
+      {
+	f ();
+      }
+    void
+    get () const
+    {
+    }
+  };
+
+///
+/// State shared by the task handles and the job completing it
+///
+template<class T>
+  struct taskState
+  {
+    enum : uint8_t
+    {
+      s_pending, s_value, s_error
+    };
+
+    explicit
+    taskState (threadPool* pool) :
+	m_pool (pool), m_status (s_pending)
+    {
+    }
+
+    threadPool* m_pool; // helped while waiting, nullptr for tasks made ready
+    std::atomic<uint8_t> m_status;
+    std::mutex m_mutex;
+    std::vector<std::function<void ()> > m_continuations;
+    std::exception_ptr m_error;
+    taskValue<T> m_value;
+
+    bool
+    ready () const
+    {
+      return m_status.load (std::memory_order_acquire) != s_pending;
+    }
+
+    ///
+    /// Runs the job unless token is cancelled, then completes the task with its result or error
+    ///
+    template<class F>
+      void
+      run (F& f, const cancelToken& token)
+      {
+	if (token.cancelled ())
+	  return complete (s_error, std::make_exception_ptr (taskCancelled ()));
+	try
+	  {
+	    m_value.run (f);
+	  }
+	catch (...)
+	  {
+	    return complete (s_error, std::current_exception ());
+	  }
+	complete (s_value, nullptr);
+      }
+
+    void
+    complete (uint8_t status, std::exception_ptr error)
+    {
+      std::vector<std::function<void ()> > continuations;
+	{
+	  std::lock_guard<std::mutex> lock (m_mutex);
+	  m_error = error;
+	  m_status.store (status, std::memory_order_release);
+	  continuations.swap (m_continuations);
+	}
+      for (std::function<void ()>& c : continuations)
+	c ();
+    }
+
+    ///
+    /// Runs c once the task is done, right away if it already is
+    ///
+    void
+    onReady (std::function<void ()> c)
+    {
+	{
+	  std::lock_guard<std::mutex> lock (m_mutex);
+	  if (m_status.load (std::memory_order_relaxed) == s_pending)
+	    {
+	      m_continuations.push_back (std::move (c));
+	      return;
+	    }
+	}
+      c ();
+    }
+  };
+
+template<class T>
+  class task
+  {
+  public:
+    task () = default;
+    explicit
+    task (std::shared_ptr<taskState<T> > state) :
+	m_state (std::move (state))
+    {
+    }
+
+    bool
+    valid () const
+    {
+      return m_state != nullptr;
+    }
+    bool
+    ready () const
+    {
+      return m_state->ready ();
+    }
+
+    void
+    wait () const
+    {
+      while (!m_state->ready ())
+	if (!m_state->m_pool || !m_state->m_pool->runOne ())
+	  std::this_thread::yield ();
+    }
+
+    ///
+    /// Waits for the result, rethrows the exception of a failed or cancelled job
+    ///
+    typename taskValue<T>::reference
+    get () const &
+    {
+      wait ();
+      if (m_state->m_status.load (std::memory_order_acquire) == taskState<T>::s_error)
+	std::rethrow_exception (m_state->m_error);
+      return m_state->m_value.get ();
+    }
+    ///
+    /// The same on a temporary task, e.g. whenAll (tasks).get (): the value is copied out, a
+    /// reference would point into a state that may go away with the temporary
+    ///
+    T
+    get () &&
+    {
+      return static_cast<T> (static_cast<const task&> (*this).get ());
+    }
+
+    ///
+    /// Task of f (*this), run once this task is done. f gets the done task and calls get () on it
+    /// to have the value or the exception.
+    ///
+    template<class F>
+      task<typename std::result_of<F (const task&)>::type>
+      then (F f, cancelToken token = cancelToken ()) const
+      {
+	typedef typename std::result_of<F (const task&)>::type R;
+	std::shared_ptr<taskState<R> > next = std::make_shared<taskState<R> > (m_state->m_pool);
+	task self (*this);
+	if (m_state->ready ())
+	  {
+	    auto body = [&self, &f]()
+	      { return f (self);};
+	    next->run (body, token);
+	  }
+	else
+	  m_state->onReady ([next, self, f, token]() mutable
+	    {
+	      auto body = [&self, &f]()
+		{ return f (self);};
+	      next->run (body, token);
+	    });
+	return task<R> (next);
+      }
+
+    const std::shared_ptr<taskState<T> >&
+    state () const
+    {
+      return m_state;
+    }
+
+  private:
+    std::shared_ptr<taskState<T> > m_state;
+  };
+
+///
+/// Runs f () on pool, unless token is cancelled before it starts
+///
+template<class F>
+  task<typename std::result_of<F ()>::type>
+  spawn (F f, cancelToken token, threadPool& pool = threadPool::global ())
+  {
+    typedef typename std::result_of<F ()>::type R;
+    std::shared_ptr<taskState<R> > state = std::make_shared<taskState<R> > (&pool);
+    pool.submit ([state, f, token]() mutable
+      {
+	state->run (f, token);
+      });
+    return task<R> (state);
+  }
+
+template<class F>
+  task<typename std::result_of<F ()>::type>
+  spawn (F f, threadPool& pool = threadPool::global ())
+  {
+    return spawn (std::move (f), cancelToken (), pool);
+  }
+
+///
+/// A task which is done already, e.g. a cached result taking the same path as computed ones
+///
+template<class T>
+  task<typename std::decay<T>::type>
+  readyTask (T&& value)
+  {
+    typedef typename std::decay<T>::type V;
+    std::shared_ptr<taskState<V> > state = std::make_shared<taskState<V> > (nullptr);
+    auto body = [&value]()
+      { return std::forward<T> (value);};
+    state->run (body, cancelToken ());
+    return task<V> (state);
+  }
+
+///
+/// Task of all values in order, done when the last of tasks is. Fails with the first failed task.
+///
+template<class T>
+  task<std::vector<T> >
+  whenAll (const std::vector<task<T> >& tasks)
+  {
+    struct joint
+    {
+      std::atomic<size_t> left;
+      std::vector<task<T> > tasks;
+      std::shared_ptr<taskState<std::vector<T> > > state;
+
+      void
+      arrive ()
+      {
+	if (left.fetch_sub (1, std::memory_order_acq_rel) != 1)
+	  return;
+	auto collect = [this]()
+	  {
+	    std::vector<T> values;
+	    values.reserve (tasks.size ());
+	    for (const task<T>& t : tasks)
+	      values.push_back (t.get ());
+	    return values;
+	  };
+	state->run (collect, cancelToken ());
+      }
+    };
+    std::shared_ptr<joint> all = std::make_shared<joint> ();
+    all->tasks = tasks;
+    all->state = std::make_shared<taskState<std::vector<T> > > (
+	tasks.empty () ? nullptr : tasks.front ().state ()->m_pool);
+    // one extra arrival for this function, so the result isn't built while still registering
+    all->left.store (tasks.size () + 1, std::memory_order_relaxed);
+    for (const task<T>& t : tasks)
+      t.state ()->onReady ([all]()
+	{
+	  all->arrive ();
+	});
+    task<std::vector<T> > result (all->state);
+    all->arrive ();
+    return result;
+  }
+
+#endif /* TASK_H_ */
@@ -0,0 +1,744 @@
+/****************************************************************************************************/
+/*                                                                                                  */
+/* @module        : Cpp 11 features examples                                                        */
+/* @file          : textStream.h                                                                    */
+/* @brief         : Streams files through lambda stages in cache sized blocks, mmap or read         */
+/* @input         :                                                                                 */
+/* @outpu         :                                                                                 */
+/* @date          : 16-October-2026                                                                 */
+/* @author        : Pratik Patil                                                                    */
+/* License        :                                                                                 */
+/*               Copyright (C) 2017  Pratik Patil                                                   */
+/*                                                                                                  */
+/*               This program is free software: you can redistribute it and/or modify               */
+/*               it under the terms of the GNU General Public License Version 3 as published by     */
+/*               the Free Software Foundation.                                                      */
+/*                                                                                                  */
+/*               This program is distributed in the hope that it will be useful,                    */
+/*               but WITHOUT ANY WARRANTY; without even the implied warranty of                     */
+/*               MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                      */
+/*               GNU General Public License for more details.                                       */
+/*                                                                                                  */
+/*               You should have received a copy of the GNU General Public License                  */
+/*               along with this program.  If not, see <http://www.gnu.org/licenses/>.              */
+/****************************************************************************************************/
+#ifndef TEXTSTREAM_H_
+#define TEXTSTREAM_H_
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "threadPool.h"
+#include "uniqueHandle.h"
+
+/*
+ * Description:
+ *   toUppserCase, countUpperCase and findFirst (LambdaExpression.cpp) work on a string that is
+ *   already in memory. A textPipeline runs the same kind of lambdas over a file of any size
+ *   without loading it:
+ *
+ *     auto pipeline = makeTextPipeline (textCount ([](char c) { return c == '\n'; }),
+ *                                       textBlocks ([](char* s, size_t n) { asciiToUpper (s, n); }),
+ *                                       textSink (STDOUT_FILENO));
+ *     mappedFile file ("server.log");
+ *     streamMapped (file, pipeline);             // or streamFile ("server.log", pipeline)
+ *     size_t lines = std::get<0> (pipeline.stages ()).count ();
+ *
+ *   Blocks -
+ *   Data moves in textBlocks of about textLimits::s_textBlock bytes (fits L2 next to the working
+ *   set). A block always ends after a '\n' (unless a single line is longer than a block), so line
+ *   based stages see whole lines. Every stage works on the block in place, one after the other;
+ *   nothing is copied between stages.
+ *
+ *   Stages -
+ *   textTransform (f)  replaces every char c by f (c)
+ *   textBlocks (f)     calls f (data, size) on the whole block, e.g. with the asciiCase kernels
+ *   textFilter (pred)  keeps the chars pred accepts, compacting the block in place
+ *   textLines (f)      calls f (line, length) for every line, without its '\n'
+ *   textCount (pred)   counts matching chars, count ()
+ *   textFind (pred)    offset in the input of the first matching char, offset (), or npos. Put it
+ *                      before any textFilter, a filter moves the chars it keeps.
+ *   textSink (fd)      writes the blocks to a file descriptor
+ *
+ *   Sources -
+ *   streamFile reads a file (or pipe) with read (2) into one reusable buffer. streamMapped runs over
+ *   a read only mappedFile, zero copy. Only if a stage changes the data (textTransform, textBlocks,
+ *   textFilter) each block is first copied into a buffer of the range, which stays in cache and
+ *   is much cheaper than copy on write faults of a writable mapping.
+ *
+ *   Parallel -
+ *   streamMapped splits big files into ranges of textLimits::s_textRange, each ending after a
+ *   '\n', and hands them to the threadPool. Every range runs through its own copy of the pipeline;
+ *   as ranges complete they are merged into the caller's pipeline strictly in file order: counts
+ *   add up, textFind keeps the earliest hit and textSink writes the output of the range, which a
+ *   range copy buffers, so output order is the same as sequential.
+ *
+ *   The merge covers only the built in state. The lambdas given to textTransform, textBlocks,
+ *   textFilter and textLines run concurrently, one copy per range, and textLines sees the lines
+ *   of different ranges in any order. Whatever such a lambda captures by reference (a counter, a
+ *   vector of lines) is then shared between threads unsynchronized. Use textCount / textFind for
+ *   counting and searching, keep the lambdas free of shared state, or run the file with
+ *   streamMappedSequential (or streamFile), which push every block on the calling thread in file
+ *   order.
+ */
+
+///
+/// A window of the input, offset is where data[0] was in the input before any filter ran
+///
+struct textBlock
+{
+  char* data;
+  size_t size;
+  uint64_t offset;
+};
+
+template<class F>
+  struct textTransformStage
+  {
+    static const bool s_writes = true;
+
+    F f;
+
+    void
+    operator () (textBlock& b)
+    {
+      // fixed 64 char rounds, see textCountStage
+      size_t i = 0;
+      for (; i + 64 <= b.size; i += 64)
+	for (size_t j = 0; j < 64; ++j)
+	  b.data[i + j] = f (b.data[i + j]);
+      for (; i < b.size; ++i)
+	b.data[i] = f (b.data[i]);
+    }
+    void
+    merge (textTransformStage&)
+    {
+    }
+    void
+    asRangeCopy ()
+    {
+    }
+  };
+
+template<class F>
+  struct textBlocksStage
+  {
+    static const bool s_writes = true;
+
+    F f;
+
+    void
+    operator () (textBlock& b)
+    {
+      f (b.data, b.size);
+    }
+    void
+    merge (textBlocksStage&)
+    {
+    }
+    void
+    asRangeCopy ()
+    {
+    }
+  };
+
+template<class PRED>
+  struct textFilterStage
+  {
+    static const bool s_writes = true;
+
+    PRED pred;
+
+    void
+    operator () (textBlock& b)
+    {
+      // branch free compaction: always write, advance by the predicate
+      size_t kept = 0;
+      for (size_t i = 0; i < b.size; ++i)
+	{
+	  char c = b.data[i];
+	  b.data[kept] = c;
+	  kept += bool (pred (c));
+	}
+      b.size = kept;
+    }
+    void
+    merge (textFilterStage&)
+    {
+    }
+    void
+    asRangeCopy ()
+    {
+    }
+  };
+
+template<class F>
+  struct textLinesStage
+  {
+    static const bool s_writes = false;
+
+    F f;
+
+    void
+    operator () (textBlock& b)
+    {
+      const char* p = b.data;
+      const char* end = b.data + b.size;
+      while (p < end)
+	{
+	  const char* nl = static_cast<const char*> (memchr (p, '\n', end - p));
+	  const char* lineEnd = nl ? nl : end;
+	  f (p, size_t (lineEnd - p));
+	  p = lineEnd + 1;
+	}
+    }
+    void
+    merge (textLinesStage&)
+    {
+    }
+    void
+    asRangeCopy ()
+    {
+    }
+  };
+
+template<class PRED>
+  class textCountStage
+  {
+  public:
+    static const bool s_writes = false;
+    explicit
+    textCountStage (PRED pred) :
+	m_pred (std::move (pred)), m_count (0)
+    {
+    }
+    void
+    operator () (textBlock& b)
+    {
+      // fixed 64 char rounds: gcc -O2 vectorizes only loops with a known trip count
+      size_t n = 0;
+      size_t i = 0;
+      for (; i + 64 <= b.size; i += 64)
+	{
+	  uint8_t hits = 0;
+	  for (size_t j = 0; j < 64; ++j)
+	    hits += bool (m_pred (b.data[i + j]));
+	  n += hits;
+	}
+      for (; i < b.size; ++i)
+	n += bool (m_pred (b.data[i]));
+      m_count += n;
+    }
+    void
+    merge (textCountStage& later)
+    {
+      m_count += later.m_count;
+    }
+    void
+    asRangeCopy ()
+    {
+      m_count = 0;
+    }
+    uint64_t
+    count () const
+    {
+      return m_count;
+    }
+
+  private:
+    PRED m_pred;
+    uint64_t m_count;
+  };
+
+template<class PRED>
+  class textFindStage
+  {
+  public:
+    static const bool s_writes = false;
+    static const uint64_t npos = ~uint64_t (0);
+
+    explicit
+    textFindStage (PRED pred) :
+	m_pred (std::move (pred)), m_offset (npos)
+    {
+    }
+    void
+    operator () (textBlock& b)
+    {
+      if (m_offset != npos)
+	return;
+      for (size_t i = 0; i < b.size; ++i)
+	if (m_pred (b.data[i]))
+	  {
+	    m_offset = b.offset + i;
+	    return;
+	  }
+    }
+    void
+    merge (textFindStage& later)
+    {
+      if (m_offset == npos)
+	m_offset = later.m_offset;
+    }
+    void
+    asRangeCopy ()
+    {
+      m_offset = npos;
+    }
+    uint64_t
+    offset () const
+    {
+      return m_offset;
+    }
+
+  private:
+    PRED m_pred;
+    uint64_t m_offset;
+  };
+
+template<class PRED>
+  const uint64_t textFindStage<PRED>::npos;
+
+class textSinkStage
+{
+public:
+  static const bool s_writes = false;
+
+  explicit
+  textSinkStage (int fd) :
+      m_fd (fd), m_buffered (false)
+  {
+  }
+  void
+  operator () (textBlock& b)
+  {
+    if (m_buffered)
+      m_pending.append (b.data, b.size);
+    else
+      write (b.data, b.size);
+  }
+  void
+  merge (textSinkStage& later)
+  {
+    write (later.m_pending.data (), later.m_pending.size ());
+    later.m_pending.clear ();
+  }
+  ///
+  /// Keeps the output until merge
+  ///
+  void
+  asRangeCopy ()
+  {
+    m_buffered = true;
+    m_pending.clear ();
+  }
+
+private:
+  int m_fd;
+  bool m_buffered;
+  std::string m_pending;
+
+  void
+  write (const char* p, size_t n)
+  {
+    while (n)
+      {
+	ssize_t written = ::write (m_fd, p, n);
+	if (written < 0)
+	  {
+	    if (errno == EINTR)
+	      continue;
+	    throw std::system_error (errno, std::system_category (), "textSink write");
+	  }
+	p += written;
+	n -= written;
+      }
+  }
+};
+
+template<class F>
+  textTransformStage<F>
+  textTransform (F f)
+  {
+    return textTransformStage<F>
+      { std::move (f) };
+  }
+template<class F>
+  textBlocksStage<F>
+  textBlocks (F f)
+  {
+    return textBlocksStage<F>
+      { std::move (f) };
+  }
+template<class PRED>
+  textFilterStage<PRED>
+  textFilter (PRED pred)
+  {
+    return textFilterStage<PRED>
+      { std::move (pred) };
+  }
+template<class F>
+  textLinesStage<F>
+  textLines (F f)
+  {
+    return textLinesStage<F>
+      { std::move (f) };
+  }
+template<class PRED>
+  textCountStage<PRED>
+  textCount (PRED pred)
+  {
+    return textCountStage<PRED> (std::move (pred));
+  }
+template<class PRED>
+  textFindStage<PRED>
+  textFind (PRED pred)
+  {
+    return textFindStage<PRED> (std::move (pred));
+  }
+inline textSinkStage
+textSink (int fd)
+{
+  return textSinkStage (fd);
+}
+
+///
+/// True if any of STAGES changes the data
+///
+template<class ... STAGES>
+  struct textWrites;
+
+template<>
+  struct textWrites<> : std::false_type
+  {
+  };
+
+template<class STAGE, class ... STAGES>
+  struct textWrites<STAGE, STAGES...> : std::integral_constant<bool,
+      STAGE::s_writes || textWrites<STAGES...>::value>
+  {
+  };
+
+template<class ... STAGES>
+  class textPipeline
+  {
+  public:
+    static const bool s_writes = textWrites<STAGES...>::value;
+
+    explicit
+    textPipeline (STAGES ... stages) :
+	m_stages (std::move (stages)...)
+    {
+    }
+
+    ///
+    /// Runs the block through all stages, stopping early if a filter emptied it
+    ///
+    void
+    push (textBlock block)
+    {
+      pushFrom<0> (block);
+    }
+
+    ///
+    /// Folds in the results of a copy that ran over the input following ours
+    ///
+    void
+    merge (textPipeline& later)
+    {
+      mergeFrom<0> (later);
+    }
+
+    ///
+    /// Makes this a copy for one range of a parallel run: results start from zero, output is
+    /// kept until the copy is merged
+    ///
+    void
+    asRangeCopy ()
+    {
+      asRangeCopyFrom<0> ();
+    }
+
+    std::tuple<STAGES...>&
+    stages ()
+    {
+      return m_stages;
+    }
+
+  private:
+    std::tuple<STAGES...> m_stages;
+
+    template<size_t I>
+      typename std::enable_if<I < sizeof...(STAGES)>::type
+      pushFrom (textBlock& block)
+      {
+	if (!block.size)
+	  return;
+	std::get<I> (m_stages) (block);
+	pushFrom<I + 1> (block);
+      }
+    template<size_t I>
+      typename std::enable_if<I == sizeof...(STAGES)>::type
+      pushFrom (textBlock&)
+      {
+      }
+
+    template<size_t I>
+      typename std::enable_if<I < sizeof...(STAGES)>::type
+      mergeFrom (textPipeline& later)
+      {
+	std::get<I> (m_stages).merge (std::get<I> (later.m_stages));
+	mergeFrom<I + 1> (later);
+      }
+    template<size_t I>
+      typename std::enable_if<I == sizeof...(STAGES)>::type
+      mergeFrom (textPipeline&)
+      {
+      }
+
+    template<size_t I>
+      typename std::enable_if<I < sizeof...(STAGES)>::type
+      asRangeCopyFrom ()
+      {
+	std::get<I> (m_stages).asRangeCopy ();
+	asRangeCopyFrom<I + 1> ();
+      }
+    template<size_t I>
+      typename std::enable_if<I == sizeof...(STAGES)>::type
+      asRangeCopyFrom ()
+      {
+      }
+  };
+
+template<class ... STAGES>
+  const bool textPipeline<STAGES...>::s_writes;
+
+template<class ... STAGES>
+  textPipeline<STAGES...>
+  makeTextPipeline (STAGES ... stages)
+  {
+    return textPipeline<STAGES...> (std::move (stages)...);
+  }
+
+///
+/// Sizes of the pieces a textPipeline is fed in
+///
+struct textLimits
+{
+  static const size_t s_textBlock = 64 << 10;   // bytes per block
+  static const size_t s_textRange = 8 << 20;    // bytes per range of a parallel run
+};
+
+///
+/// Closes the file descriptor of a uniqueHandle, so the sources close it when a stage throws
+///
+struct textFdDeleter
+{
+  static int
+  invalid ()
+  {
+    return -1;
+  }
+  void
+  operator () (int fd) const
+  {
+    ::close (fd);
+  }
+};
+typedef uniqueHandle<int, textFdDeleter> textFd;
+
+///
+/// Read only mapping of a whole file
+///
+class mappedFile
+{
+public:
+  explicit
+  mappedFile (const char* path) :
+      m_data (nullptr), m_size (0)
+  {
+    textFd fd (::open (path, O_RDONLY));
+    if (!fd)
+      throw std::system_error (errno, std::system_category (), path);
+    struct stat st;
+    if (fstat (fd.get (), &st) < 0)
+      throw std::system_error (errno, std::system_category (), path);
+    m_size = st.st_size;
+    if (m_size)
+      {
+	void* p = mmap (nullptr, m_size, PROT_READ, MAP_PRIVATE, fd.get (), 0);
+	if (p == MAP_FAILED)
+	  throw std::system_error (errno, std::system_category (), path);
+	m_data = static_cast<char*> (p);
+	madvise (m_data, m_size, MADV_SEQUENTIAL);
+      }
+  }
+  ~mappedFile ()
+  {
+    if (m_data)
+      munmap (m_data, m_size);
+  }
+  mappedFile (const mappedFile&) = delete;
+  mappedFile&
+  operator = (const mappedFile&) = delete;
+
+  const char*
+  data () const
+  {
+    return m_data;
+  }
+  size_t
+  size () const
+  {
+    return m_size;
+  }
+
+private:
+  char* m_data;
+  size_t m_size;
+};
+
+///
+/// End of the piece starting at begin: about want bytes, moved to just after the next '\n'
+///
+inline size_t
+textPieceEnd (const char* data, size_t begin, size_t want, size_t size)
+{
+  if (size - begin <= want)
+    return size;
+  size_t end = begin + want;
+  const char* nl = static_cast<const char*> (memchr (data + end, '\n', size - end));
+  return nl ? size_t (nl - data) + 1 : size;
+}
+
+template<class PIPELINE>
+  void
+  streamRange (const char* data, size_t begin, size_t end, PIPELINE& pipeline)
+  {
+    const size_t blockSize = textLimits::s_textBlock;
+    std::vector<char> copy (PIPELINE::s_writes ? blockSize : 0);
+    while (begin < end)
+      {
+	size_t blockEnd = textPieceEnd (data, begin, blockSize, end);
+	textBlock b =
+	  { const_cast<char*> (data) + begin, blockEnd - begin, begin };
+	if (PIPELINE::s_writes)
+	  {
+	    if (copy.size () < b.size)
+	      copy.resize (b.size);
+	    memcpy (copy.data (), b.data, b.size);
+	    b.data = copy.data ();
+	  }
+	pipeline.push (b);
+	begin = blockEnd;
+      }
+  }
+
+///
+/// Runs pipeline over a mapped file on the calling thread, in file order
+///
+template<class PIPELINE>
+  void
+  streamMappedSequential (mappedFile& file, PIPELINE& pipeline)
+  {
+    streamRange (file.data (), 0, file.size (), pipeline);
+  }
+
+///
+/// Runs pipeline over a mapped file, in parallel ranges when the file is bigger than one range
+///
+template<class PIPELINE>
+  void
+  streamMapped (mappedFile& file, PIPELINE& pipeline, threadPool& pool = threadPool::global ())
+  {
+    const char* data = file.data ();
+    size_t size = file.size ();
+    const size_t rangeSize = textLimits::s_textRange;
+    if (size <= rangeSize || pool.size () < 2)
+      {
+	streamMappedSequential (file, pipeline);
+	return;
+      }
+    std::vector<size_t> bounds (1, 0);
+    while (bounds.back () < size)
+      bounds.push_back (textPieceEnd (data, bounds.back (), rangeSize, size));
+    size_t ranges = bounds.size () - 1;
+
+    // copied before the workers start, pipeline itself is merged into while they run
+    PIPELINE prototype (pipeline);
+    prototype.asRangeCopy ();
+    std::vector<std::unique_ptr<PIPELINE> > done (ranges);
+    std::mutex mutex;
+    size_t next = 0;
+    pool.forRange (0, ranges, 1, [&](size_t b, size_t e)
+      {
+	for (size_t r = b; r < e; ++r)
+	  {
+	    std::unique_ptr<PIPELINE> copy (new PIPELINE (prototype));
+	    streamRange (data, bounds[r], bounds[r + 1], *copy);
+	    std::lock_guard<std::mutex> lock (mutex);
+	    done[r] = std::move (copy);
+	    // merge every range whose predecessors are all merged, in file order
+	    for (; next < ranges && done[next]; ++next)
+	      {
+		pipeline.merge (*done[next]);
+		done[next].reset ();
+	      }
+	  }
+      });
+  }
+
+///
+/// Runs pipeline over a file or pipe read piece by piece into one buffer
+///
+template<class PIPELINE>
+  void
+  streamFile (const char* path, PIPELINE& pipeline)
+  {
+    textFd fd (::open (path, O_RDONLY));
+    if (!fd)
+      throw std::system_error (errno, std::system_category (), path);
+    const size_t blockSize = textLimits::s_textBlock;
+    std::unique_ptr<char[]> buffer (new char[2 * blockSize]);
+    size_t filled = 0;
+    uint64_t offset = 0;
+    for (;;)
+      {
+	ssize_t n = ::read (fd.get (), buffer.get () + filled, 2 * blockSize - filled);
+	if (n < 0 && errno == EINTR)
+	  continue;
+	if (n < 0)
+	  throw std::system_error (errno, std::system_category (), path);
+	filled += n;
+	if (n == 0 || filled >= blockSize)
+	  {
+	    // up to the last '\n', or everything at the end of the input or if there is no '\n'
+	    size_t end = filled;
+	    const void* nl = n ? memrchr (buffer.get (), '\n', filled) : nullptr;
+	    if (nl)
+	      end = static_cast<const char*> (nl) - buffer.get () + 1;
+	    textBlock b =
+	      { buffer.get (), end, offset };
+	    if (end)
+	      pipeline.push (b);
+	    offset += end;
+	    memmove (buffer.get (), buffer.get () + end, filled - end);
+	    filled -= end;
+	  }
+	if (n == 0)
+	  break;
+      }
+  }
+
+#endif /* TEXTSTREAM_H_ */
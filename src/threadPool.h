@@ -0,0 +1,344 @@
+/****************************************************************************************************/
+/*                                                                                                  */
+/* @module        : Cpp 11 features examples                                                        */
+/* @file          : threadPool.h                                                                    */
+/* @brief         : Work stealing thread pool and parallel for_each/transform/reduce                */
+/* @input         :                                                                                 */
+/* @outpu         :                                                                                 */
+/* @date          : 16-October-2026                                                                 */
+/* @author        : Pratik Patil                                                                    */
+/* License        :                                                                                 */
+/*               Copyright (C) 2017  Pratik Patil                                                   */
+/*                                                                                                  */
+/*               This program is free software: you can redistribute it and/or modify               */
+/*               it under the terms of the GNU General Public License Version 3 as published by     */
+/*               the Free Software Foundation.                                                      */
+/*                                                                                                  */
+/*               This program is distributed in the hope that it will be useful,                    */
+/*               but WITHOUT ANY WARRANTY; without even the implied warranty of                     */
+/*               MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                      */
+/*               GNU General Public License for more details.                                       */
+/*                                                                                                  */
+/*               You should have received a copy of the GNU General Public License                  */
+/*               along with this program.  If not, see <http://www.gnu.org/licenses/>.              */
+/****************************************************************************************************/
+#ifndef THREADPOOL_H_
+#define THREADPOOL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/*
+ * Description:
+ *   threadPool keeps its worker threads for the life of the program (threadPool::global ()), so
+ *   parallel algorithms don't start threads per call.
+ *
+ *   Work stealing -
+ *   Every worker has its own deque of tasks. It pushes and pops at the back, which keeps recently
+ *   split (cache warm) work local, and when it runs dry it steals from the front of another
+ *   worker's deque, where the biggest pieces sit.
+ *
+ *   forRange (begin, end, grain, body) -
+ *   The range is split in halves; one half is pushed for others to steal, the other half is split
+ *   further, until pieces are at most grain long and body (b, e) runs on them. An idle worker thus
+ *   always finds a big piece to steal, so uneven work per element balances by itself, and the
+ *   grain only has to be big enough to hide the task overhead. The calling thread works on tasks
+ *   too while it waits, which also makes nested parallel calls from inside a task safe.
+ *   The first exception thrown by body is rethrown to the caller.
+ *
+ *   parallelForEach / parallelTransform / parallelReduce take random access iterators and the same
+ *   lambdas as for_each, transform and accumulate. The lambdas run concurrently, so whatever they
+ *   capture by reference must be safe to use from several threads. parallelReduce expects op to be
+ *   associative; partial results are combined in range order.
+ */
+
+class threadPool
+{
+public:
+  explicit
+  threadPool (unsigned threads = 0) :
+      m_next (0), m_pending (0), m_stop (false)
+  {
+    if (threads == 0)
+      threads = std::max (1u, std::thread::hardware_concurrency ());
+    for (unsigned i = 0; i < threads; ++i)
+      m_queues.push_back (std::unique_ptr<queue> (new queue ()));
+    for (unsigned i = 0; i < threads; ++i)
+      m_threads.push_back (std::thread (&threadPool::workerLoop, this, i));
+  }
+  ~threadPool ()
+  {
+      {
+	std::lock_guard<std::mutex> lock (m_sleepMutex);
+	m_stop = true;
+      }
+    m_wake.notify_all ();
+    for (std::thread& t : m_threads)
+      t.join ();
+  }
+  threadPool (const threadPool&) = delete;
+  threadPool&
+  operator = (const threadPool&) = delete;
+
+  ///
+  /// Pool shared by all parallel algorithms, one worker per core
+  ///
+  static threadPool&
+  global ()
+  {
+    static threadPool pool;
+    return pool;
+  }
+
+  unsigned
+  size () const
+  {
+    return m_queues.size ();
+  }
+
+  void
+  submit (std::function<void ()> task)
+  {
+    current& c = currentWorker ();
+    size_t index = c.pool == this ? c.index : m_next++ % m_queues.size ();
+      {
+	std::lock_guard<std::mutex> lock (m_queues[index]->mutex);
+	m_queues[index]->tasks.push_back (std::move (task));
+      }
+    m_pending.fetch_add (1);
+      {
+	// taking the lock orders this with a worker that is about to sleep
+	std::lock_guard<std::mutex> lock (m_sleepMutex);
+      }
+    m_wake.notify_one ();
+  }
+
+  ///
+  /// Runs one queued task on the calling thread, if there is any. Used while waiting.
+  ///
+  bool
+  runOne ()
+  {
+    current& c = currentWorker ();
+    std::function<void ()> task;
+    if (!take (c.pool == this ? c.index : 0, task))
+      return false;
+    task ();
+    return true;
+  }
+
+  template<class BODY>
+    void
+    forRange (size_t begin, size_t end, size_t grain, BODY body)
+    {
+      if (begin >= end)
+	return;
+      if (grain == 0)
+	grain = 1;
+      std::shared_ptr<rangeJob<BODY> > job (new rangeJob<BODY> (*this, grain, body));
+      job->split (job, begin, end);
+      while (job->m_outstanding.load () != 0)
+	if (!runOne ())
+	  std::this_thread::yield ();
+      if (job->m_failed.load ())
+	std::rethrow_exception (job->m_error);
+    }
+
+  ///
+  /// Grain giving every worker several pieces to balance with
+  ///
+  size_t
+  defaultGrain (size_t n) const
+  {
+    size_t grain = n / (8 * size ());
+    return grain ? grain : 1;
+  }
+
+private:
+  struct queue
+  {
+    std::mutex mutex;
+    std::deque<std::function<void ()> > tasks;
+  };
+  struct current
+  {
+    threadPool* pool;
+    size_t index;
+  };
+
+  template<class BODY>
+    struct rangeJob
+    {
+      threadPool& m_pool;
+      size_t m_grain;
+      BODY m_body;
+      std::atomic<size_t> m_outstanding;
+      std::atomic<bool> m_failed;
+      std::mutex m_errorMutex;
+      std::exception_ptr m_error;
+
+      rangeJob (threadPool& pool, size_t grain, BODY& body) :
+	  m_pool (pool), m_grain (grain), m_body (body), m_outstanding (1), m_failed (false)
+      {
+      }
+
+      // Expects m_outstanding to already count this piece
+      void
+      split (const std::shared_ptr<rangeJob>& self, size_t begin, size_t end)
+      {
+	while (end - begin > m_grain)
+	  {
+	    size_t mid = begin + (end - begin) / 2;
+	    m_outstanding.fetch_add (1);
+	    std::shared_ptr<rangeJob> job (self);
+	    m_pool.submit ([job, mid, end]()
+	      {
+		job->split (job, mid, end);
+	      });
+	    end = mid;
+	  }
+	if (!m_failed.load ())
+	  {
+	    try
+	      {
+		m_body (begin, end);
+	      }
+	    catch (...)
+	      {
+		std::lock_guard<std::mutex> lock (m_errorMutex);
+		if (!m_failed.load ())
+		  m_error = std::current_exception ();
+		m_failed.store (true);
+	      }
+	  }
+	m_outstanding.fetch_sub (1);
+      }
+    };
+
+  std::vector<std::unique_ptr<queue> > m_queues;
+  std::vector<std::thread> m_threads;
+  std::atomic<size_t> m_next;
+  std::atomic<size_t> m_pending;
+  std::mutex m_sleepMutex;
+  std::condition_variable m_wake;
+  bool m_stop;
+
+  static current&
+  currentWorker ()
+  {
+    static thread_local current c =
+      { nullptr, 0 };
+    return c;
+  }
+
+  // Own deque from the back, else steal from the front of the others
+  bool
+  take (size_t self, std::function<void ()>& task)
+  {
+    if (m_pending.load () == 0)
+      return false;
+    size_t n = m_queues.size ();
+    for (size_t i = 0; i < n; ++i)
+      {
+	queue& q = *m_queues[(self + i) % n];
+	std::lock_guard<std::mutex> lock (q.mutex);
+	if (q.tasks.empty ())
+	  continue;
+	if (i == 0)
+	  {
+	    task = std::move (q.tasks.back ());
+	    q.tasks.pop_back ();
+	  }
+	else
+	  {
+	    task = std::move (q.tasks.front ());
+	    q.tasks.pop_front ();
+	  }
+	m_pending.fetch_sub (1);
+	return true;
+      }
+    return false;
+  }
+
+  void
+  workerLoop (size_t index)
+  {
+    current& c = currentWorker ();
+    c.pool = this;
+    c.index = index;
+    std::function<void ()> task;
+    for (;;)
+      {
+	if (take (index, task))
+	  {
+	    task ();
+	    task = nullptr;
+	    continue;
+	  }
+	std::unique_lock<std::mutex> lock (m_sleepMutex);
+	m_wake.wait (lock, [this]()
+	  { return m_stop || m_pending.load () != 0;});
+	if (m_stop && m_pending.load () == 0)
+	  return;
+      }
+  }
+};
+
+template<class ITER, class FUNC>
+  void
+  parallelForEach (ITER first, ITER last, FUNC f, threadPool& pool = threadPool::global ())
+  {
+    size_t n = std::distance (first, last);
+    pool.forRange (0, n, pool.defaultGrain (n), [first, &f](size_t b, size_t e)
+      {
+	std::for_each (first + b, first + e, f);
+      });
+  }
+
+template<class ITER, class OUT, class FUNC>
+  OUT
+  parallelTransform (ITER first, ITER last, OUT out, FUNC f, threadPool& pool = threadPool::global ())
+  {
+    size_t n = std::distance (first, last);
+    pool.forRange (0, n, pool.defaultGrain (n), [first, out, &f](size_t b, size_t e)
+      {
+	std::transform (first + b, first + e, out + b, f);
+      });
+    return out + n;
+  }
+
+template<class ITER, class T, class OP>
+  T
+  parallelReduce (ITER first, ITER last, T init, OP op, threadPool& pool = threadPool::global ())
+  {
+    size_t n = std::distance (first, last);
+    std::mutex mutex;
+    std::vector<std::pair<size_t, T> > partials;
+    pool.forRange (0, n, pool.defaultGrain (n), [first, &op, &mutex, &partials](size_t b, size_t e)
+      {
+	T sum = first[b];
+	for (size_t i = b + 1; i < e; ++i)
+	  sum = op (sum, first[i]);
+	std::lock_guard<std::mutex> lock (mutex);
+	partials.push_back (std::make_pair (b, sum));
+      });
+    std::sort (partials.begin (), partials.end (), [](const std::pair<size_t, T>& a,
+						      const std::pair<size_t, T>& b)
+      { return a.first < b.first;});
+    for (const std::pair<size_t, T>& p : partials)
+      init = op (init, p.second);
+    return init;
+  }
+
+#endif /* THREADPOOL_H_ */
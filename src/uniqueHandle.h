@@ -0,0 +1,165 @@
+/****************************************************************************************************/
+/*                                                                                                  */
+/* @module        : Cpp 11 features examples                                                        */
+/* @file          : uniqueHandle.h                                                                  */
+/* @brief         : Move only owner of a handle (pointer, descriptor, ...) and its deleter          */
+/* @input         :                                                                                 */
+/* @outpu         :                                                                                 */
+/* @date          : 16-October-2026                                                                 */
+/* @author        : Pratik Patil                                                                    */
+/* License        :                                                                                 */
+/*               Copyright (C) 2017  Pratik Patil                                                   */
+/*                                                                                                  */
+/*               This program is free software: you can redistribute it and/or modify               */
+/*               it under the terms of the GNU General Public License Version 3 as published by     */
+/*               the Free Software Foundation.                                                      */
+/*                                                                                                  */
+/*               This program is distributed in the hope that it will be useful,                    */
+/*               but WITHOUT ANY WARRANTY; without even the implied warranty of                     */
+/*               MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                      */
+/*               GNU General Public License for more details.                                       */
+/*                                                                                                  */
+/*               You should have received a copy of the GNU General Public License                  */
+/*               along with this program.  If not, see <http://www.gnu.org/licenses/>.              */
+/****************************************************************************************************/
+#ifndef UNIQUEHANDLE_H_
+#define UNIQUEHANDLE_H_
+
+#include <type_traits>
+#include <utility>
+
+/*
+ * Description:
+ *   deletedCopyStruct (deleted_Default.cpp) shows how deleting the copy constructor and copy
+ *   assignment stops an object from being copied. Without move operations such an object can't
+ *   be returned from a function, put in a container or handed to another owner either.
+ *
+ *   uniqueHandle<T, DELETER> owns one handle of type T: a pointer, a file descriptor, a pooled
+ *   object... Copying is deleted like in deletedCopyStruct, moving transfers ownership and leaves
+ *   the source empty, and the destructor gives the handle to DELETER. DELETER says what an empty
+ *   handle looks like and how to get rid of a valid one:
+ *
+ *     struct fdDeleter
+ *     {
+ *       static int invalid () { return -1; }
+ *       void operator () (int fd) const { ::close (fd); }
+ *     };
+ *     typedef uniqueHandle<int, fdDeleter> uniqueFd;
+ *
+ *   A deleter may carry state (e.g. the pool an object goes back to), it is moved with the handle.
+ */
+
+template<class T, class DELETER>
+  class uniqueHandle
+  {
+  public:
+    uniqueHandle () :
+	m_handle (DELETER::invalid ())
+    {
+    }
+    explicit
+    uniqueHandle (T handle, DELETER deleter = DELETER ()) :
+	m_handle (handle), m_deleter (std::move (deleter))
+    {
+    }
+    ~uniqueHandle ()
+    {
+      reset ();
+    }
+
+    uniqueHandle (const uniqueHandle&) = delete;
+    uniqueHandle&
+    operator = (const uniqueHandle&) = delete;
+
+    uniqueHandle (uniqueHandle&& h) noexcept :
+	m_handle (h.release ()), m_deleter (std::move (h.m_deleter))
+    {
+    }
+    uniqueHandle&
+    operator = (uniqueHandle&& h) noexcept
+    {
+      if (this != &h)
+	{
+	  reset (h.release ());
+	  m_deleter = std::move (h.m_deleter);
+	}
+      return *this;
+    }
+
+    T
+    get () const
+    {
+      return m_handle;
+    }
+    ///
+    /// Only for pointer handles
+    ///
+    typename std::remove_pointer<T>::type&
+    operator * () const
+    {
+      return *m_handle;
+    }
+    T
+    operator -> () const
+    {
+      return m_handle;
+    }
+    explicit
+    operator bool () const
+    {
+      return !(m_handle == DELETER::invalid ());
+    }
+
+    ///
+    /// Gives up ownership without deleting, the handle is returned to the caller
+    ///
+    T
+    release ()
+    {
+      T handle = m_handle;
+      m_handle = DELETER::invalid ();
+      return handle;
+    }
+
+    ///
+    /// Deletes the current handle (if any) and takes ownership of handle
+    ///
+    void
+    reset (T handle = DELETER::invalid ())
+    {
+      T old = m_handle;
+      m_handle = handle;
+      if (!(old == DELETER::invalid ()))
+	m_deleter (old);
+    }
+
+    DELETER&
+    deleter ()
+    {
+      return m_deleter;
+    }
+
+  private:
+    T m_handle;
+    DELETER m_deleter;
+  };
+
+///
+/// Deleter for objects created with new
+///
+template<class T>
+  struct deletePointer
+  {
+    static T*
+    invalid ()
+    {
+      return nullptr;
+    }
+    void
+    operator () (T* p) const
+    {
+      delete p;
+    }
+  };
+
+#endif /* UNIQUEHANDLE_H_ */